@@ -58,4 +58,56 @@ namespace embree
   };
 
   parallel_for_regression_test parallel_for_regression("parallel_for_regression_test");
+
+#if defined(TASKING_INTERNAL)
+
+  /* runs background and interactive task schedulers concurrently */
+  struct task_priority_regression_test : public RegressionTest
+  {
+    task_priority_regression_test(const char* name) : RegressionTest(name) {
+      registerRegressionTest(this);
+    }
+
+    static size_t sum_of_squares(size_t N)
+    {
+      std::atomic<size_t> sum(0);
+      parallel_for( size_t(0), size_t(N), size_t(1024), [&](const range<size_t>& r) 
+      {
+        size_t s = 0;
+        for (size_t i=r.begin(); i<r.end(); i++) 
+          s += i*i;
+        sum += s;
+      });
+      return sum;
+    }
+
+    static void background_thread(void* ptr)
+    {
+      std::pair<size_t,size_t>* sums = (std::pair<size_t,size_t>*) ptr;
+      Ref<TaskScheduler> scheduler = new TaskScheduler(TaskScheduler::PRIORITY_BACKGROUND);
+      scheduler->spawn_root([&]() { sums->second = sum_of_squares(sums->first); });
+    }
+    
+    bool run ()
+    {
+      const size_t N = 10000000;
+      size_t sum0 = 0;
+      for (size_t i=0; i<N; i++)
+        sum0 += i*i;
+
+      std::pair<size_t,size_t> sums(N,0);
+      thread_t thread = createThread(background_thread,&sums);
+
+      bool passed = true;
+      for (size_t m=0; m<10; m++)
+        passed &= sum_of_squares(N) == sum0;
+
+      join(thread);
+      passed &= sums.second == sum0;
+      return passed;
+    }
+  };
+
+  task_priority_regression_test task_priority_regression("task_priority_regression_test");
+#endif
 }
@@ -55,3 +55,4 @@ SET(EMBREE_GEOMETRY_CURVE @EMBREE_GEOMETRY_CURVE@)
 SET(EMBREE_GEOMETRY_SUBDIVISION @EMBREE_GEOMETRY_SUBDIVISION@)
 SET(EMBREE_GEOMETRY_USER @EMBREE_GEOMETRY_USER@)
 SET(EMBREE_RAY_PACKETS @EMBREE_RAY_PACKETS@)
+SET(EMBREE_MAX_INSTANCE_LEVEL_COUNT @EMBREE_MAX_INSTANCE_LEVEL_COUNT@)
@@ -46,6 +46,10 @@ namespace embree
   }
 
   static bool huge_pages_enabled = false;
+  static bool numa_interleave_enabled = false;
+  static __thread ssize_t numa_thread_node = -1;
+  static bool file_backing_enabled = false;
+  static std::string file_backing_directory;
   static MutexSys os_init_mutex;
 
   __forceinline bool isHugePageCandidate(const size_t bytes) 
@@ -57,6 +61,13 @@ namespace embree
     const size_t hbytes = (bytes+PAGE_SIZE_2M-1) & ~size_t(PAGE_SIZE_2M-1);
     return 66*(hbytes-bytes) < bytes; // at most 1.5% overhead
   }
+
+  /* writes one byte per 4k page such that all pages of the range get faulted in */
+  __forceinline void touchPages(void* ptr, size_t bytes)
+  {
+    for (size_t i=0; i<bytes; i+=PAGE_SIZE_4K)
+      ((volatile char*)ptr)[i] = 0;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,7 +131,7 @@ namespace embree
     return true;
   }
 
-  void* os_malloc(size_t bytes, bool& hugepages)
+  void* os_malloc(size_t bytes, bool& hugepages, bool prefault)
   {
     if (bytes == 0) {
       hugepages = false;
@@ -143,6 +154,7 @@ namespace embree
     char* ptr = (char*) VirtualAlloc(nullptr,bytes,flags,PAGE_READWRITE);
     if (ptr == nullptr) throw std::bad_alloc();
     hugepages = false;
+    if (prefault) touchPages(ptr,bytes);
     return ptr;
   }
 
@@ -175,6 +187,60 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  bool os_init_numa(bool interleave, bool verbose)
+  {
+    /* Windows places pages on the node of the first touching thread */
+    numa_interleave_enabled = false;
+    if (interleave && verbose) std::cout << "WARNING: NUMA interleaving not supported on this platform!" << std::endl;
+    return !interleave;
+  }
+
+  void os_interleave(void* ptr, size_t bytes)
+  {
+  }
+
+  void os_set_numa_node(ssize_t node)
+  {
+  }
+
+  bool os_init_file_backing(const std::string& directory, bool verbose)
+  {
+    if (directory != "" && verbose) std::cout << "WARNING: file backed memory not supported on this platform!" << std::endl;
+    return directory == "";
+  }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file,&size) || size.QuadPart == 0) {
+      CloseHandle(file);
+      return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_WRITECOPY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr) return nullptr;
+
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_COPY,0,0,0);
+    CloseHandle(mapping);
+    if (ptr == nullptr) return nullptr;
+
+    bytes = (size_t) size.QuadPart;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (!UnmapViewOfFile(ptr))
+      throw std::bad_alloc();
+  }
 }
 
 #endif
@@ -186,6 +252,9 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -195,6 +264,15 @@ namespace embree
 #include <mach/vm_statistics.h>
 #endif
 
+#if defined(__LINUX__)
+#include <sys/syscall.h>
+#if !defined(MPOL_INTERLEAVE)
+#define MPOL_DEFAULT    0
+#define MPOL_PREFERRED  1
+#define MPOL_INTERLEAVE 3
+#endif
+#endif
+
 namespace embree
 {
   bool os_init(bool hugepages, bool verbose) 
@@ -246,13 +324,63 @@ namespace embree
     return true;
   }
 
-  void* os_malloc(size_t bytes, bool& hugepages)
+  /* maps an unlinked temporary file, the kernel writes its pages back to that file under memory pressure */
+  static void* os_malloc_file_backed(size_t bytes)
+  {
+    std::string fileName;
+    {
+      Lock<MutexSys> lock(os_init_mutex);
+      fileName = file_backing_directory + "/embree.XXXXXX";
+    }
+    std::vector<char> path(fileName.begin(),fileName.end());
+    path.push_back(0);
+
+    int fd = mkstemp(path.data());
+    if (fd == -1) return nullptr;
+    unlink(path.data());
+
+    if (ftruncate(fd,bytes) == -1) {
+      close(fd);
+      return nullptr;
+    }
+
+    /* the mapping keeps the file alive until it gets unmapped */
+    void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) return nullptr;
+    return ptr;
+  }
+
+  /* faults in all pages of an anonymous mapping, in one system call where supported */
+  static void os_prefault(void* ptr, size_t bytes)
+  {
+#if defined(__LINUX__)
+#if !defined(MADV_POPULATE_WRITE)
+#define MADV_POPULATE_WRITE 23
+#endif
+    if (madvise(ptr,bytes,MADV_POPULATE_WRITE) == 0)
+      return;
+#endif
+    touchPages(ptr,bytes);
+  }
+
+  void* os_malloc(size_t bytes, bool& hugepages, bool prefault)
   { 
     if (bytes == 0) {
       hugepages = false;
       return nullptr;
     }
 
+    /* file backed memory if enabled, falls back to anonymous memory on failure */
+    if (file_backing_enabled)
+    {
+      void* ptr = os_malloc_file_backed(bytes);
+      if (ptr != nullptr) {
+        hugepages = false;
+        return ptr;
+      }
+    }
+
     /* try direct huge page allocation first */
     if (isHugePageCandidate(bytes)) 
     {
@@ -260,12 +388,21 @@ namespace embree
       void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
       if (ptr != MAP_FAILED) {
         hugepages = true;
+        if (prefault) touchPages(ptr,bytes);
         return ptr;
       }
 #else
-      void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON | MAP_HUGETLB, -1, 0);
+#if defined(__LINUX__)
+      /* populating at map time would place pages before the interleave policy is set */
+      const int populate = prefault && !numa_interleave_enabled ? MAP_POPULATE : 0;
+#else
+      const int populate = 0;
+#endif
+      void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON | MAP_HUGETLB | populate, -1, 0);
       if (ptr != MAP_FAILED) {
         hugepages = true;
+        os_interleave(ptr,bytes);
+        if (prefault && !populate) os_prefault(ptr,bytes);
         return ptr;
       }
 #endif
@@ -278,6 +415,10 @@ namespace embree
 
     /* advise huge page hint for THP */
     os_advise(ptr,bytes);
+    os_interleave(ptr,bytes);
+
+    /* fault in pages after the hints such that THP and the interleave policy apply */
+    if (prefault) os_prefault(ptr,bytes);
     return ptr;
   }
 
@@ -314,6 +455,101 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+  bool os_init_numa(bool interleave, bool verbose)
+  {
+    Lock<MutexSys> lock(os_init_mutex);
+    numa_interleave_enabled = false;
+    if (!interleave)
+      return true;
+
+#if defined(__LINUX__)
+    /* interleaving only makes sense with multiple nodes */
+    if (getNumberOfNumaNodes() > 1)
+      numa_interleave_enabled = true;
+    return true;
+#else
+    if (verbose) std::cout << "WARNING: NUMA interleaving not supported on this platform!" << std::endl;
+    return false;
+#endif
+  }
+
+  /* distributes the pages of the range round robin over all NUMA nodes */
+  void os_interleave(void* ptr, size_t bytes)
+  {
+#if defined(__LINUX__)
+    if (!numa_interleave_enabled || numa_thread_node >= 0)
+      return;
+
+    /* only pages fully inside the range may get a policy */
+    const size_t begin = ((size_t)ptr + PAGE_SIZE_4K-1) & ~size_t(PAGE_SIZE_4K-1);
+    const size_t end   = ((size_t)ptr + bytes) & ~size_t(PAGE_SIZE_4K-1);
+    if (end <= begin)
+      return;
+
+    const size_t numNodes = getNumberOfNumaNodes();
+    unsigned long nodemask = numNodes >= 8*sizeof(unsigned long) ? ~0ul : (1ul << numNodes)-1;
+    syscall(SYS_mbind,begin,end-begin,MPOL_INTERLEAVE,&nodemask,8*sizeof(nodemask),0); // on purpose no error handling, placement is only a hint
+#endif
+  }
+
+  void os_set_numa_node(ssize_t node)
+  {
+#if defined(__LINUX__)
+    numa_thread_node = node;
+    if (node < 0 || node >= ssize_t(8*sizeof(unsigned long))) {
+      syscall(SYS_set_mempolicy,MPOL_DEFAULT,nullptr,0);
+      return;
+    }
+    unsigned long nodemask = 1ul << node;
+    syscall(SYS_set_mempolicy,MPOL_PREFERRED,&nodemask,8*sizeof(nodemask)); // on purpose no error handling, placement is only a hint
+#endif
+  }
+
+  bool os_init_file_backing(const std::string& directory, bool verbose)
+  {
+    Lock<MutexSys> lock(os_init_mutex);
+    file_backing_enabled = false;
+    file_backing_directory = directory;
+    if (directory == "")
+      return true;
+
+    if (access(directory.c_str(),W_OK) == -1) {
+      if (verbose) std::cout << "WARNING: directory " << directory << " not writable. File backed memory cannot get enabled!" << std::endl;
+      return false;
+    }
+    file_backing_enabled = true;
+    return true;
+  }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    int fd = open(fileName,O_RDONLY);
+    if (fd == -1) return nullptr;
+
+    struct stat st;
+    if (fstat(fd,&st) == -1 || st.st_size == 0) {
+      close(fd);
+      return nullptr;
+    }
+
+    /* private mapping, thus pages we write to get copied */
+    void* ptr = mmap(0, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) return nullptr;
+
+    bytes = (size_t) st.st_size;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (munmap(ptr,bytes) == -1)
+      throw std::bad_alloc();
+  }
 }
 
 #endif
@@ -69,11 +69,25 @@ namespace embree
   /*! allocates pages directly from OS */
   bool win_enable_selockmemoryprivilege(bool verbose);
   bool os_init(bool hugepages, bool verbose);
-  void* os_malloc (size_t bytes, bool& hugepages);
+  void* os_malloc (size_t bytes, bool& hugepages, bool prefault = false);
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages);
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! enables interleaving of OS allocated memory across all NUMA nodes */
+  bool os_init_numa (bool interleave, bool verbose);
+  void os_interleave (void* ptr, size_t bytes);
+
+  /*! places memory first touched by the calling thread on the specified NUMA node, -1 restores the default placement */
+  void os_set_numa_node (ssize_t node);
+
+  /*! backs OS allocated memory by unlinked files in the specified directory, an empty directory restores anonymous memory */
+  bool os_init_file_backing (const std::string& directory, bool verbose);
+
+  /*! maps a file copy-on-write into memory, returns nullptr on failure */
+  void* os_map_file   (const char* fileName, size_t& bytes);
+  void  os_unmap_file (void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
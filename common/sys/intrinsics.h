@@ -406,6 +406,15 @@ namespace embree
     return _mm_popcnt_u64(in);
   }
 #endif
+
+#else
+
+  /*! portable fallback for ISAs without popcnt instruction */
+  __forceinline size_t popcnt(size_t in) {
+    size_t n = 0;
+    for (; in; in &= in-1) n++;
+    return n;
+  }
   
 #endif
 
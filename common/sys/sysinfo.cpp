@@ -404,6 +404,16 @@ namespace embree
     return (double)val.QuadPart / (double)freq.QuadPart;
   }
 
+  double getCPUSeconds()
+  {
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(),&creationTime,&exitTime,&kernelTime,&userTime))
+      return 0.0;
+    const unsigned long long kernel = (unsigned long long)kernelTime.dwHighDateTime << 32 | kernelTime.dwLowDateTime;
+    const unsigned long long user   = (unsigned long long)userTime  .dwHighDateTime << 32 | userTime  .dwLowDateTime;
+    return double(kernel+user)*1E-7; // 100ns units
+  }
+
   void sleepSeconds(double t) {
     Sleep(DWORD(1000.0*t));
   }
@@ -421,6 +431,18 @@ namespace embree
     GetProcessMemoryInfo( GetCurrentProcess( ), &info, sizeof(info) );
     return (size_t)info.WorkingSetSize;
   }
+
+  size_t getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  size_t getNumaNodeOfLogicalThread(size_t threadID) {
+    return 0;
+  }
+
+  size_t getNumaNodeOfCallingThread() {
+    return 0;
+  }
 }
 #endif
 
@@ -432,6 +454,9 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
+#include <vector>
+#include <algorithm>
 
 namespace embree
 {
@@ -460,6 +485,58 @@ namespace embree
     buffer >> virt >> resident >> shared;
     return resident*sysconf(_SC_PAGE_SIZE);
   }
+
+  /* parses the NUMA topology, result[i] is the node of logical thread i */
+  static std::vector<size_t> parseNumaTopology()
+  {
+    std::vector<size_t> threadNodes;
+    for (size_t nodeID=0;;nodeID++)
+    {
+      std::ifstream fs("/sys/devices/system/node/node" + toString(nodeID) + "/cpulist");
+      if (fs.fail()) break;
+
+      /* cpulist is of the form 0-23,48-71 */
+      size_t first, last;
+      while (fs >> first)
+      {
+        last = first;
+        if (fs.peek() == '-') { fs.ignore(); fs >> last; }
+        if (threadNodes.size() <= last) threadNodes.resize(last+1,0);
+        for (size_t i=first; i<=last; i++) threadNodes[i] = nodeID;
+        if (fs.peek() == ',') fs.ignore();
+      }
+    }
+    return threadNodes;
+  }
+
+  static const std::vector<size_t>& getNumaTopology()
+  {
+    static const std::vector<size_t> threadNodes = parseNumaTopology();
+    return threadNodes;
+  }
+
+  size_t getNumberOfNumaNodes()
+  {
+    const std::vector<size_t>& threadNodes = getNumaTopology();
+    size_t numNodes = 1;
+    for (size_t i=0; i<threadNodes.size(); i++)
+      numNodes = std::max(numNodes,threadNodes[i]+1);
+    return numNodes;
+  }
+
+  size_t getNumaNodeOfLogicalThread(size_t threadID)
+  {
+    const std::vector<size_t>& threadNodes = getNumaTopology();
+    if (threadID >= threadNodes.size()) return 0;
+    return threadNodes[threadID];
+  }
+
+  size_t getNumaNodeOfCallingThread()
+  {
+    const int cpuID = sched_getcpu();
+    if (cpuID < 0) return 0;
+    return getNumaNodeOfLogicalThread(cpuID);
+  }
 }
 
 #endif
@@ -492,6 +569,18 @@ namespace embree
   size_t getResidentMemoryBytes() {
     return 0;
   }
+
+  size_t getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  size_t getNumaNodeOfLogicalThread(size_t threadID) {
+    return 0;
+  }
+
+  size_t getNumaNodeOfCallingThread() {
+    return 0;
+  }
 }
 
 #endif
@@ -522,6 +611,18 @@ namespace embree
   size_t getResidentMemoryBytes() {
     return 0;
   }
+
+  size_t getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  size_t getNumaNodeOfLogicalThread(size_t threadID) {
+    return 0;
+  }
+
+  size_t getNumaNodeOfCallingThread() {
+    return 0;
+  }
 }
 
 #endif
@@ -535,6 +636,7 @@ namespace embree
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
+#include <sys/resource.h>
 
 namespace embree
 {
@@ -558,6 +660,13 @@ namespace embree
     return double(tp.tv_sec) + double(tp.tv_usec)/1E6;
   }
 
+  double getCPUSeconds()
+  {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF,&usage) != 0) return 0.0;
+    return double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)/1E6;
+  }
+
   void sleepSeconds(double t) {
     usleep(1000000.0*t);
   }
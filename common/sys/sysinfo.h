@@ -164,6 +164,15 @@ namespace embree
 
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
+
+  /*! return the number of NUMA nodes of the system */
+  size_t getNumberOfNumaNodes();
+
+  /*! return the NUMA node the specified logical thread belongs to */
+  size_t getNumaNodeOfLogicalThread(size_t threadID);
+
+  /*! return the NUMA node the calling thread currently runs on */
+  size_t getNumaNodeOfCallingThread();
   
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
@@ -171,6 +180,9 @@ namespace embree
   /*! returns performance counter in seconds */
   double getSeconds();
 
+  /*! returns the CPU time consumed by all threads of the process in seconds */
+  double getCPUSeconds();
+
   /*! sleeps the specified number of seconds */
   void sleepSeconds(double t);
 
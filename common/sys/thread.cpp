@@ -92,6 +92,10 @@ namespace embree
     setAffinity(GetCurrentThread(), affinity);
   }
 
+  void setNumaThreadMapping(bool enable) {
+    /* the processor group order already keeps NUMA nodes together */
+  }
+
   struct ThreadStartupData 
   {
   public:
@@ -177,6 +181,7 @@ namespace embree
 {
   static MutexSys mutex;
   static std::vector<size_t> threadIDs;
+  static bool numaThreadMapping = false;
   
   /* changes thread ID mapping such that we first fill up all thread on one core */
   size_t mapThreadID(size_t threadID)
@@ -217,6 +222,13 @@ namespace embree
           }
         }
       }
+
+      /* fill up all cores of one NUMA node before using the next node */
+      if (numaThreadMapping && getNumberOfNumaNodes() > 1) {
+        std::stable_sort(threadIDs.begin(),threadIDs.end(),[] (size_t a, size_t b) {
+            return getNumaNodeOfLogicalThread(a) < getNumaNodeOfLogicalThread(b);
+          });
+      }
     }
 
     /* re-map threadIDs if mapping is available */
@@ -227,6 +239,14 @@ namespace embree
     return ID;
   }
 
+  void setNumaThreadMapping(bool enable)
+  {
+    Lock<MutexSys> lock(mutex);
+    if (numaThreadMapping == enable) return;
+    numaThreadMapping = enable;
+    threadIDs.clear(); // forces re-parsing of the topology
+  }
+
   /*! set affinity of the calling thread */
   void setAffinity(ssize_t affinity)
   {
@@ -260,6 +280,9 @@ namespace embree
     if (pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) != 0)
       WARNING("pthread_setaffinity_np failed"); // on purpose only a warning
   }
+
+  void setNumaThreadMapping(bool enable) {
+  }
 }
 #endif
 
@@ -283,6 +306,9 @@ namespace embree
     if (thread_policy_set(mach_thread_self(),THREAD_AFFINITY_POLICY,(thread_policy_t)&ap,THREAD_AFFINITY_POLICY_COUNT) != KERN_SUCCESS)
       WARNING("setting thread affinity failed"); // on purpose only a warning
   }
+
+  void setNumaThreadMapping(bool enable) {
+  }
 }
 #endif
 
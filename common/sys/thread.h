@@ -36,6 +36,9 @@ namespace embree
   /*! set affinity of the calling thread */
   void setAffinity(ssize_t affinity);
 
+  /*! when enabled, thread IDs get mapped such that all hardware threads of one NUMA node are used before the next node */
+  void setNumaThreadMapping(bool enable);
+
   /*! the thread calling this function gets yielded */
   void yield();
 
@@ -149,7 +149,7 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false), maxPriority(-1) {}
 
   dll_export void TaskScheduler::ThreadPool::startThreads()
   {
@@ -206,6 +206,7 @@ namespace embree
   {
     mutex.lock();
     schedulers.push_back(scheduler);
+    maxPriority = max(maxPriority.load(),int(scheduler->priority));
     mutex.unlock();
     condition.notify_all();
   }
@@ -216,9 +217,37 @@ namespace embree
     for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
       if (scheduler == *it) {
         schedulers.erase(it);
-        return;
+        break;
       }
     }
+
+    int priority = -1;
+    for (auto& s : schedulers) priority = max(priority,int(s->priority));
+    maxPriority = priority;
+  }
+
+  Ref<TaskScheduler> TaskScheduler::ThreadPool::select(int minPriority)
+  {
+    Ref<TaskScheduler> scheduler = nullptr;
+    for (auto& s : schedulers) {
+      if (s->priority > minPriority && (scheduler == null || s->priority > scheduler->priority))
+        scheduler = s;
+    }
+    return scheduler;
+  }
+
+  bool TaskScheduler::ThreadPool::run_higher_priority(int priority)
+  {
+    Ref<TaskScheduler> scheduler = nullptr;
+    ssize_t threadIndex = -1;
+    {
+      Lock<MutexSys> lock(mutex);
+      scheduler = select(priority);
+      if (scheduler == null) return false;
+      threadIndex = scheduler->allocThreadIndex();
+    }
+    scheduler->thread_loop(threadIndex,true);
+    return true;
   }
 
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
@@ -231,15 +260,15 @@ namespace embree
         Lock<MutexSys> lock(mutex);
         condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
         if (globalThreadIndex >= numThreadsRunning) break;
-        scheduler = schedulers.front();
+        scheduler = select(-1);
         threadIndex = scheduler->allocThreadIndex();
       }
-      scheduler->thread_loop(threadIndex);
+      scheduler->thread_loop(threadIndex,true);
     }
   }
 
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false)
+  TaskScheduler::TaskScheduler(Priority priority)
+    : priority(priority), threadCounter(0), anyTasksRunning(0), hasRootTask(false)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
@@ -335,7 +364,7 @@ namespace embree
     return thread->scheduler->cancellingException == nullptr;
   }
 
-  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex)
+  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex, bool preemptible)
   {
     /* allocate thread structure */
     std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
@@ -347,12 +376,16 @@ namespace embree
     while (anyTasksRunning)
     {
       steal_loop(thread,
-                 [&] () { return anyTasksRunning > 0; },
+                 [&] () { return anyTasksRunning > 0 && !(preemptible && threadPool->hasHigherPriority(priority)); },
                  [&] () {
                    anyTasksRunning++;
                    while (thread.tasks.execute_local_internal(thread,nullptr));
                    anyTasksRunning--;
                  });
+
+      /* between tasks our local task queue is empty, thus we can help schedulers of higher priority */
+      if (preemptible && anyTasksRunning)
+        threadPool->run_higher_priority(priority);
     }
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
@@ -38,6 +38,12 @@ namespace embree
     static const size_t TASK_STACK_SIZE = 4*1024;           //!< task structure stack
     static const size_t CLOSURE_STACK_SIZE = 512*1024;    //!< stack for task closures
 
+    /*! priority classes of task schedulers, worker threads prefer schedulers of higher priority */
+    enum Priority {
+      PRIORITY_BACKGROUND  = 0,   //!< background work like scene builds
+      PRIORITY_INTERACTIVE = 1    //!< latency sensitive work like rendering a frame
+    };
+
     struct Thread;
 
     /*! virtual interface for all tasks */
@@ -212,11 +218,24 @@ namespace embree
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
 
+      /*! true if a scheduler of higher priority waits for threads */
+      __forceinline bool hasHigherPriority(int priority) const {
+        return maxPriority > priority;
+      }
+
+      /*! lets the calling thread help a scheduler of higher priority, returns false if there is none */
+      bool run_higher_priority(int priority);
+
+    private:
+      /*! returns the scheduler with highest priority above minPriority, the oldest one for equal priorities */
+      Ref<TaskScheduler> select(int minPriority);
+
     private:
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
       bool set_affinity;
       std::atomic<bool> running;
+      std::atomic<int> maxPriority;
       std::vector<thread_t> threads;
 
     private:
@@ -225,7 +244,7 @@ namespace embree
       std::list<Ref<TaskScheduler> > schedulers;
     };
 
-    TaskScheduler ();
+    TaskScheduler (Priority priority = PRIORITY_INTERACTIVE);
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
@@ -244,8 +263,8 @@ namespace embree
     /*! wait for some number of threads available (threadCount includes main thread) */
     void wait_for_threads(size_t threadCount);
 
-    /*! thread loop for all worker threads */
-    std::exception_ptr thread_loop(size_t threadIndex);
+    /*! thread loop for all worker threads, preemptible threads leave for schedulers of higher priority */
+    std::exception_ptr thread_loop(size_t threadIndex, bool preemptible = false);
 
     /*! steals a task from a different thread */
     bool steal_from_other_threads(Thread& thread);
@@ -360,6 +379,7 @@ namespace embree
     dll_export static void removeScheduler(const Ref<TaskScheduler>& scheduler);
 
   private:
+    const Priority priority;
     std::vector<atomic<Thread*>> threadLocal;
     std::atomic<size_t> threadCounter;
     std::atomic<size_t> anyTasksRunning;
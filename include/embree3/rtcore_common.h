@@ -68,9 +68,6 @@ typedef int ssize_t;
 /* Maximum number of time steps */
 #define RTC_MAX_TIME_STEP_COUNT 129
 
-/* Maximum number of instancing levels */
-#define RTC_MAX_INSTANCE_LEVEL_COUNT 1
-
 /* Formats of buffers and other data structures */
 enum RTCFormat
 {
@@ -196,7 +193,8 @@ enum RTCIntersectContextFlags
 {
   RTC_INTERSECT_CONTEXT_FLAG_NONE       = 0,
   RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT = (0 << 0), // optimize for incoherent rays
-  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0)  // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0), // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_SORT_RAYS  = (1 << 1)  // sort incoherent ray streams by origin and direction
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -218,7 +216,7 @@ struct RTCIntersectContext
 {
   enum RTCIntersectContextFlags flags;               // intersection flags
   RTCFilterFunctionN filter;                         // filter function to execute
-  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // will be set to geomID of instance when instance is entered
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // stack of instance geomIDs, set when instances are entered
 };
 
 /* Initializes an intersection context. */
@@ -226,8 +224,31 @@ RTC_FORCEINLINE void rtcInitIntersectContext(struct RTCIntersectContext* context
 {
   context->flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
   context->filter = NULL;
-  context->instID[0] = RTC_INVALID_GEOMETRY_ID;
+  for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    context->instID[l] = RTC_INVALID_GEOMETRY_ID;
 }
+
+/* Point query structure for closest point and radius queries */
+struct RTC_ALIGN(16) RTCPointQuery
+{
+  float x;      // x coordinate of the query point
+  float y;      // y coordinate of the query point
+  float z;      // z coordinate of the query point
+  float time;   // time of the point query
+  float radius; // radius of the point query
+};
+
+/* Arguments for RTCPointQueryFunction */
+struct RTCPointQueryFunctionArguments
+{
+  struct RTCPointQuery* query;
+  void* userPtr;
+  unsigned int primID;
+  unsigned int geomID;
+};
+
+/* Point query callback function, returns true if the query radius got modified */
+typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
   
 #if defined(__cplusplus)
 }
@@ -51,6 +51,7 @@ enum RTCDeviceProperty
   RTC_DEVICE_PROPERTY_BACKFACE_CULLING_ENABLED    = 65,
   RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED   = 66,
   RTC_DEVICE_PROPERTY_IGNORE_INVALID_RAYS_ENABLED = 67,
+  RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_ENABLED = 68,
 
   RTC_DEVICE_PROPERTY_TRIANGLE_GEOMETRY_SUPPORTED    = 96,
   RTC_DEVICE_PROPERTY_QUAD_GEOMETRY_SUPPORTED        = 97,
@@ -68,6 +69,31 @@ RTC_API ssize_t rtcGetDeviceProperty(RTCDevice device, enum RTCDeviceProperty pr
 /* Sets a device property. */
 RTC_API void rtcSetDeviceProperty(RTCDevice device, const enum RTCDeviceProperty prop, ssize_t value);
   
+/* Traversal counters gathered while RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_ENABLED is set */
+struct RTCTraversalStatistics
+{
+  size_t intersectRays;      // number of rays traced with rtcIntersect functions
+  size_t occludedRays;       // number of rays traced with rtcOccluded functions
+  size_t nodeVisits;         // number of inner node visits summed over all rays
+  size_t leafVisits;         // number of leaf visits summed over all rays
+  size_t primitiveTests;     // number of primitive block intersection tests summed over all rays
+  size_t filterCalls;        // number of intersection and occlusion filter function invocations
+  size_t triangleHits;       // number of closest hits per geometry type
+  size_t quadHits;
+  size_t gridHits;
+  size_t subdivisionHits;
+  size_t curveHits;
+  size_t pointHits;
+  size_t userHits;
+  size_t instanceHits;       // number of closest hits inside instanced scenes
+};
+
+/* Returns the traversal counters summed over all threads. */
+RTC_API void rtcGetDeviceTraversalStatistics(RTCDevice device, struct RTCTraversalStatistics* stats);
+
+/* Resets the traversal counters to zero. */
+RTC_API void rtcResetDeviceTraversalStatistics(RTCDevice device);
+
 /* Error codes */
 enum RTCError
 {
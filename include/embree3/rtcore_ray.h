@@ -63,6 +63,13 @@ struct RTCRayHit
   struct RTCHit hit;
 };
 
+/* Hit record returned by the multi-hit queries */
+struct RTCHitRecord
+{
+  float t;            // hit distance along the ray
+  struct RTCHit hit;  // hit data
+};
+
 /* Ray structure for a packet of 4 rays */
 struct RTC_ALIGN(16) RTCRay4
 {
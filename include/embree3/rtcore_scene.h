@@ -29,6 +29,9 @@ struct RTCRayHit8;
 struct RTCRayHit16;
 struct RTCRayHitNp;
 
+/* Opaque commit future type */
+typedef struct RTCCommitFutureTy* RTCCommitFuture;
+
 /* Scene flags */
 enum RTCSceneFlags
 {
@@ -36,7 +39,9 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_NUMA_REPLICATION        = (1 << 4),
+  RTC_SCENE_FLAG_LOW_MEMORY_BUILD        = (1 << 5)
 };
 
 /* Creates a new scene. */
@@ -68,6 +73,53 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Commits the scene asynchronously and returns a future for the commit. */
+RTC_API RTCCommitFuture rtcCommitSceneAsync(RTCScene scene);
+
+/* Returns true if the commit of the future has finished. */
+RTC_API bool rtcIsCommitFutureReady(RTCCommitFuture future);
+
+/* Waits until the commit of the future has finished. */
+RTC_API void rtcWaitCommitFuture(RTCCommitFuture future);
+
+/* Retains the commit future (increments the reference count). */
+RTC_API void rtcRetainCommitFuture(RTCCommitFuture future);
+
+/* Releases the commit future (decrements the reference count). */
+RTC_API void rtcReleaseCommitFuture(RTCCommitFuture future);
+
+/* Writes the acceleration structure of a committed scene to a file. */
+RTC_API void rtcSaveSceneBVH(RTCScene scene, const char* filename);
+
+/* Commits the scene using the acceleration structure stored in a file. */
+RTC_API void rtcLoadSceneBVH(RTCScene scene, const char* filename);
+
+/* Returns the predicted peak memory consumption in bytes of the next scene commit. */
+RTC_API size_t rtcGetSceneBuildMemoryEstimate(RTCScene scene);
+
+/* Limits the memory consumption of scene commits, builders reduce the BVH quality to stay within the budget. */
+RTC_API void rtcSetSceneBuildMemoryBudget(RTCScene scene, size_t bytes);
+
+/* Timings in seconds and memory consumption of a scene commit */
+struct RTCBuildStatistics
+{
+  double commitTime;         // wall clock time of the entire commit
+  double primRefTime;        // time spent creating build primitives
+  double hierarchyTime;      // time spent constructing hierarchies, divided into the next three times
+  double binningTime;        // time spent in SAH binning and partitioning
+  double spatialSplitTime;   // time spent in spatial split binning and partitioning
+  double leafTime;           // time spent creating leaves
+  double topLevelTime;       // time spent building top-level hierarchies over per-geometry hierarchies
+  double refitTime;          // time spent refitting hierarchies
+  float threadUtilization;   // average fraction of build threads busy during the commit
+  unsigned int numThreads;   // number of build threads
+  size_t bytesAllocated;     // memory allocated by the acceleration structures
+  size_t bytesUsed;          // memory used by the acceleration structures
+};
+
+/* Returns the build statistics of the last scene commit. */
+RTC_API void rtcGetSceneBuildStatistics(RTCScene scene, struct RTCBuildStatistics* stats);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -102,6 +154,18 @@ RTC_API void rtcIntersect8(const int* valid, RTCScene scene, struct RTCIntersect
 /* Intersects a packet of 16 rays with the scene. */
 RTC_API void rtcIntersect16(const int* valid, RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit16* rayhit);
 
+/* Intersects a single ray with the scene and collects up to maxHits hits sorted by distance. */
+RTC_API unsigned int rtcIntersect1Hits(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit, struct RTCHitRecord* hits, unsigned int maxHits);
+
+/* Intersects a packet of 4 rays with the scene and collects up to maxHits hits per ray sorted by distance. */
+RTC_API void rtcIntersect4Hits(const int* valid, RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit4* rayhit, struct RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits);
+
+/* Intersects a packet of 8 rays with the scene and collects up to maxHits hits per ray sorted by distance. */
+RTC_API void rtcIntersect8Hits(const int* valid, RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit8* rayhit, struct RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits);
+
+/* Intersects a packet of 16 rays with the scene and collects up to maxHits hits per ray sorted by distance. */
+RTC_API void rtcIntersect16Hits(const int* valid, RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit16* rayhit, struct RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits);
+
 /* Intersects a stream of M rays with the scene. */
 RTC_API void rtcIntersect1M(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit, unsigned int M, size_t byteStride);
 
@@ -138,6 +202,9 @@ RTC_API void rtcOccludedNM(RTCScene scene, struct RTCIntersectContext* context,
 /* Tests a stream of M ray packets of size N in SOA format for occlusion with the scene. */
 RTC_API void rtcOccludedNp(RTCScene scene, struct RTCIntersectContext* context, const struct RTCRayNp* ray, unsigned int N);
 
+/* Traverses the scene with a point query, returns true if any primitive was reported. */
+RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, RTCPointQueryFunction queryFunc, void* userPtr);
+
 #if defined(__cplusplus)
 
 /* Helper for easily combining scene flags */
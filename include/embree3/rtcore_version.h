@@ -19,3 +19,6 @@
 #define RTC_VERSION_PATCH 0
 #define RTC_VERSION 30200
 #define RTC_VERSION_STRING "3.2.0"
+
+/* Maximum number of instancing levels */
+#define RTC_MAX_INSTANCE_LEVEL_COUNT 1
@@ -0,0 +1,438 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bvh_builder_morton.h"
+#include "../../common/algorithms/parallel_filter.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Parallel locally-ordered clustering (PLOC) builder. Primitives
+     *  are sorted by their morton codes and clustered bottom-up by
+     *  repeatedly merging clusters that are mutual nearest neighbours
+     *  (smallest merged surface area) within a small window of the
+     *  morton order. The resulting binary tree is collapsed into a
+     *  BVH with the requested branching factor. */
+    struct BVHBuilderPLOC
+    {
+      static const size_t MAX_BRANCHING_FACTOR = BVHBuilderMorton::MAX_BRANCHING_FACTOR; //!< maximum supported BVH branching factor
+      static const size_t MIN_LARGE_LEAF_LEVELS = BVHBuilderMorton::MIN_LARGE_LEAF_LEVELS; //!< create balanced tree of we are that many levels before the maximum tree depth
+      static const size_t SEARCH_RADIUS = 16;                //!< number of clusters searched to each side for the nearest neighbour
+      static const size_t MAX_LOCAL_STACK_SIZE = 64;         //!< clusters with more primitives gather their primitives using a heap allocated stack
+
+      typedef BVHBuilderMorton::Settings Settings;
+      typedef BVHBuilderMorton::BuildPrim BuildPrim;
+
+      /*! node of the binary cluster tree */
+      struct Cluster
+      {
+        __forceinline Cluster () {}
+
+        __forceinline Cluster (const BBox3fa& bounds, unsigned primID)
+          : bounds(bounds), left(-1), right(-1), size(1), primID(primID) {}
+
+        __forceinline Cluster (const BBox3fa& bounds, unsigned left, unsigned right, unsigned size)
+          : bounds(bounds), left(left), right(right), size(size), primID(-1) {}
+
+        __forceinline bool isLeaf() const { return left == unsigned(-1); }
+
+      public:
+        BBox3fa bounds;   //!< bounds of all primitives of the cluster
+        unsigned left;    //!< first child cluster
+        unsigned right;   //!< second child cluster
+        unsigned size;    //!< number of primitives of the cluster
+        unsigned primID;  //!< primitive of a leaf cluster
+      };
+
+      template<
+        typename ReductionTy,
+        typename Allocator,
+        typename CreateAllocator,
+        typename CreateNodeFunc,
+        typename SetNodeBoundsFunc,
+        typename CreateLeafFunc,
+        typename CalculateBounds,
+        typename ProgressMonitor>
+
+        class BuilderT : private Settings
+      {
+        ALIGNED_CLASS_(16);
+
+      public:
+
+        BuilderT (CreateAllocator& createAllocator,
+                  CreateNodeFunc& createNode,
+                  SetNodeBoundsFunc& setBounds,
+                  CreateLeafFunc& createLeaf,
+                  CalculateBounds& calculateBounds,
+                  ProgressMonitor& progressMonitor,
+                  const Settings& settings)
+
+          : Settings(settings),
+          createAllocator(createAllocator),
+          createNode(createNode),
+          setBounds(setBounds),
+          createLeaf(createLeaf),
+          calculateBounds(calculateBounds),
+          progressMonitor(progressMonitor),
+          morton(nullptr) {}
+
+        /*! finds for each cluster the cluster in the search window whose merged bounds have smallest surface area */
+        void findNearestNeighbours(size_t numClusters)
+        {
+          parallel_for(size_t(0), numClusters, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                const BBox3fa bounds = active[i];
+                const size_t begin = i > SEARCH_RADIUS ? i-SEARCH_RADIUS : 0;
+                const size_t end = min(i+SEARCH_RADIUS+1,numClusters);
+                float bestArea = pos_inf;
+                unsigned bestNeighbour = i > 0 ? unsigned(i-1) : unsigned(i+1);
+                for (size_t j=begin; j<end; j++)
+                {
+                  if (j == i) continue;
+                  const float area = halfArea(merge(bounds,active[j]));
+                  if (area < bestArea) {
+                    bestArea = area;
+                    bestNeighbour = unsigned(j);
+                  }
+                }
+                nearest[i] = bestNeighbour;
+              }
+            });
+        }
+
+        /*! merges two clusters into a new cluster */
+        __forceinline BBox3fa mergeClusters(const BBox3fa& left, const BBox3fa& right)
+        {
+          const unsigned leftID = left.lower.u, rightID = right.lower.u;
+          const unsigned id = numAllocatedClusters++;
+          clusters[id] = Cluster(merge(left,right),leftID,rightID,clusters[leftID].size+clusters[rightID].size);
+          return activeCluster(id);
+        }
+
+        /*! merges all mutual nearest neighbours, returns the new number of clusters */
+        size_t mergeClusters(size_t numClusters)
+        {
+          parallel_for(size_t(0), numClusters, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                const unsigned j = nearest[i];
+                if (nearest[j] != i) {
+                  nextActive[i] = active[i];
+                } else if (i < j) {
+                  nextActive[i] = mergeClusters(active[i],active[j]);
+                } else {
+                  nextActive[i].lower.u = -1;
+                }
+              }
+            });
+
+          std::swap(active,nextActive);
+          return parallel_filter(active.data(),size_t(0),numClusters,size_t(1024),[] (const BBox3fa& b) { return b.lower.u != unsigned(-1); });
+        }
+
+        /*! bounds of a not yet merged cluster with its ID */
+        __forceinline BBox3fa activeCluster(unsigned id) const
+        {
+          BBox3fa bounds = clusters[id].bounds;
+          bounds.lower.u = id;
+          return bounds;
+        }
+
+        /*! copies the primitives of a cluster in tree order to the morton array */
+        void gatherPrimitives(unsigned clusterID, unsigned begin)
+        {
+          /* the stack never holds more entries than the cluster has primitives */
+          unsigned localStack[MAX_LOCAL_STACK_SIZE];
+          std::vector<unsigned> largeStack;
+          unsigned* stack = localStack;
+          if (clusters[clusterID].size > MAX_LOCAL_STACK_SIZE) {
+            largeStack.resize(clusters[clusterID].size);
+            stack = largeStack.data();
+          }
+
+          size_t stackSize = 0;
+          stack[stackSize++] = clusterID;
+          while (stackSize)
+          {
+            const Cluster& cluster = clusters[stack[--stackSize]];
+            if (cluster.isLeaf()) {
+              morton[begin].code = 0;
+              morton[begin].index = cluster.primID;
+              begin++;
+            } else {
+              stack[stackSize++] = cluster.right;
+              stack[stackSize++] = cluster.left;
+            }
+          }
+        }
+
+        ReductionTy createLargeLeaf(size_t depth, const range<unsigned>& current, Allocator alloc)
+        {
+          /* this should never occur but is a fatal error */
+          if (depth > maxDepth)
+            throw_RTCError(RTC_ERROR_UNKNOWN,"depth limit reached");
+
+          /* create leaf for few primitives */
+          if (current.size() <= maxLeafSize)
+            return createLeaf(current,alloc);
+
+          /* fill all children by always splitting the largest one */
+          range<unsigned> children[MAX_BRANCHING_FACTOR];
+          size_t numChildren = 1;
+          children[0] = current;
+
+          do {
+
+            /* find best child with largest number of primitives */
+            size_t bestChild = -1;
+            size_t bestSize = 0;
+            for (size_t i=0; i<numChildren; i++)
+            {
+              /* ignore leaves as they cannot get split */
+              if (children[i].size() <= maxLeafSize)
+                continue;
+
+              /* remember child with largest size */
+              if (children[i].size() > bestSize) {
+                bestSize = children[i].size();
+                bestChild = i;
+              }
+            }
+            if (bestChild == size_t(-1)) break;
+
+            /*! split best child into left and right child */
+            auto split = children[bestChild].split();
+
+            /* add new children left and right */
+            children[bestChild] = children[numChildren-1];
+            children[numChildren-1] = split.first;
+            children[numChildren+0] = split.second;
+            numChildren++;
+
+          } while (numChildren < branchingFactor);
+
+          /* create node */
+          auto node = createNode(alloc,numChildren);
+
+          /* recurse into each child */
+          ReductionTy bounds[MAX_BRANCHING_FACTOR];
+          for (size_t i=0; i<numChildren; i++)
+            bounds[i] = createLargeLeaf(depth+1,children[i],alloc);
+
+          return setBounds(node,bounds,numChildren);
+        }
+
+        ReductionTy recurse(size_t depth, unsigned clusterID, unsigned begin, Allocator alloc, bool toplevel)
+        {
+          /* get thread local allocator */
+          if (!alloc)
+            alloc = createAllocator();
+
+          const Cluster& cluster = clusters[clusterID];
+          const range<unsigned> current(begin,begin+cluster.size);
+
+          /* call memory monitor function to signal progress */
+          if (toplevel && current.size() <= singleThreadThreshold)
+            progressMonitor(current.size());
+
+          /* create leaf node */
+          if (unlikely(depth+MIN_LARGE_LEAF_LEVELS >= maxDepth || current.size() <= minLeafSize || cluster.isLeaf())) {
+            gatherPrimitives(clusterID,begin);
+            return createLargeLeaf(depth,current,alloc);
+          }
+
+          /* fill all children by always opening the cluster with the largest surface area */
+          unsigned children[MAX_BRANCHING_FACTOR];
+          children[0] = cluster.left;
+          children[1] = cluster.right;
+          size_t numChildren = 2;
+
+          while (numChildren < branchingFactor)
+          {
+            /* find best child with largest surface area, preferring
+               children that are too large to become leaves */
+            int bestChild = -1;
+            bool bestLarge = false;
+            float bestArea = neg_inf;
+            for (unsigned int i=0; i<numChildren; i++)
+            {
+              /* ignore leaves as they cannot get opened */
+              const Cluster& child = clusters[children[i]];
+              if (child.isLeaf())
+                continue;
+
+              /* remember child with largest area */
+              const bool large = child.size > minLeafSize;
+              const float area = halfArea(child.bounds);
+              if ((large && !bestLarge) || (large == bestLarge && area > bestArea)) {
+                bestLarge = large;
+                bestArea = area;
+                bestChild = i;
+              }
+            }
+            if (bestChild == -1) break;
+
+            /*! replace best child by its left and right child */
+            const Cluster& child = clusters[children[bestChild]];
+            children[bestChild] = children[numChildren-1];
+            children[numChildren-1] = child.left;
+            children[numChildren+0] = child.right;
+            numChildren++;
+          }
+
+          /* the children get consecutive ranges of the morton array */
+          unsigned childBegin[MAX_BRANCHING_FACTOR];
+          for (size_t i=0; i<numChildren; i++) {
+            childBegin[i] = begin;
+            begin += clusters[children[i]].size;
+          }
+
+          /* allocate node */
+          auto node = createNode(alloc,numChildren);
+
+          /* process top parts of tree parallel */
+          ReductionTy bounds[MAX_BRANCHING_FACTOR];
+          if (current.size() > singleThreadThreshold)
+          {
+            /*! parallel_for is faster than spawing sub-tasks */
+            parallel_for(size_t(0), numChildren, [&] (const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                  bounds[i] = recurse(depth+1,children[i],childBegin[i],nullptr,true);
+                  _mm_mfence(); // to allow non-temporal stores during build
+                }
+              });
+          }
+
+          /* finish tree sequentially */
+          else
+          {
+            for (size_t i=0; i<numChildren; i++)
+              bounds[i] = recurse(depth+1,children[i],childBegin[i],alloc,false);
+          }
+
+          return setBounds(node,bounds,numChildren);
+        }
+
+        /* build function */
+        ReductionTy build(BuildPrim* src, BuildPrim* tmp, size_t numPrimitives)
+        {
+          /* sort morton codes */
+          morton = src;
+          radix_sort_u32(src,tmp,numPrimitives,singleThreadThreshold);
+
+          /* create one cluster per primitive in morton order */
+          clusters.resize(2*numPrimitives-1);
+          active.resize(numPrimitives);
+          nextActive.resize(numPrimitives);
+          nearest.resize(numPrimitives);
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++) {
+                clusters[i] = Cluster(calculateBounds(morton[i]),morton[i].index);
+                active[i] = activeCluster(unsigned(i));
+              }
+            });
+          numAllocatedClusters = unsigned(numPrimitives);
+
+          /* merge mutual nearest neighbours until a single cluster is left */
+          size_t numClusters = numPrimitives;
+          while (numClusters > 1)
+          {
+            findNearestNeighbours(numClusters);
+            const size_t numMergedClusters = mergeClusters(numClusters);
+
+            /* the globally closest pair is always mutual, thus we only get here for invalid bounds */
+            if (unlikely(numMergedClusters == numClusters)) {
+              active[0] = mergeClusters(active[0],active[1]);
+              std::copy(active.begin()+2,active.begin()+numClusters,active.begin()+1);
+              numClusters--;
+              continue;
+            }
+            numClusters = numMergedClusters;
+          }
+          const unsigned rootID = active[0].lower.u;
+
+          /* collapse cluster tree into BVH */
+          const ReductionTy root = recurse(1, rootID, 0, nullptr, true);
+          _mm_mfence(); // to allow non-temporal stores during build
+          return root;
+        }
+
+      public:
+        CreateAllocator& createAllocator;
+        CreateNodeFunc& createNode;
+        SetNodeBoundsFunc& setBounds;
+        CreateLeafFunc& createLeaf;
+        CalculateBounds& calculateBounds;
+        ProgressMonitor& progressMonitor;
+
+      public:
+        BuildPrim* morton;
+        avector<Cluster> clusters;   //!< all clusters of the binary cluster tree
+        avector<BBox3fa> active;     //!< bounds of the not yet merged clusters in morton order, the cluster ID is stored in lower.u
+        avector<BBox3fa> nextActive;
+        std::vector<unsigned> nearest;   //!< nearest neighbour of each not yet merged cluster
+        std::atomic<unsigned> numAllocatedClusters;
+      };
+
+
+      template<
+      typename ReductionTy,
+        typename CreateAllocFunc,
+        typename CreateNodeFunc,
+        typename SetBoundsFunc,
+        typename CreateLeafFunc,
+        typename CalculateBoundsFunc,
+        typename ProgressMonitor>
+
+        static ReductionTy build(CreateAllocFunc createAllocator,
+                                 CreateNodeFunc createNode,
+                                 SetBoundsFunc setBounds,
+                                 CreateLeafFunc createLeaf,
+                                 CalculateBoundsFunc calculateBounds,
+                                 ProgressMonitor progressMonitor,
+                                 BuildPrim* src,
+                                 BuildPrim* tmp,
+                                 size_t numPrimitives,
+                                 const Settings& settings)
+        {
+          typedef BuilderT<
+            ReductionTy,
+            decltype(createAllocator()),
+            CreateAllocFunc,
+            CreateNodeFunc,
+            SetBoundsFunc,
+            CreateLeafFunc,
+            CalculateBoundsFunc,
+            ProgressMonitor> Builder;
+
+          Builder builder(createAllocator,
+                          createNode,
+                          setBounds,
+                          createLeaf,
+                          calculateBounds,
+                          progressMonitor,
+                          settings);
+
+          return builder.build(src,tmp,numPrimitives);
+        }
+    };
+  }
+}
@@ -19,6 +19,7 @@
 #include "heuristic_binning_array_aligned.h"
 #include "heuristic_spatial_array.h"
 #include "heuristic_openmerge_array.h"
+#include "../common/buildstat.h"
 
 #if defined(__AVX512F__) && !defined(__AVX512VL__) // KNL
 #  define NUM_OBJECT_BINS 16
@@ -46,12 +47,12 @@ namespace embree
         /*! default settings */
         Settings ()
         : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(8),
-          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf) {}
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf), stats(nullptr), splitTask(BuildStatistics::BINNING) {}
 
         /*! initialize settings from API settings */
         Settings (const RTCBuildArguments& settings)
         : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(8),
-          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf)
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024), primrefarrayalloc(inf), stats(nullptr), splitTask(BuildStatistics::BINNING)
         {
           if (RTC_BUILD_ARGUMENTS_HAS(settings,maxBranchingFactor)) branchingFactor = settings.maxBranchingFactor;
           if (RTC_BUILD_ARGUMENTS_HAS(settings,maxDepth          )) maxDepth        = settings.maxDepth;
@@ -64,7 +65,7 @@ namespace embree
 
         Settings (size_t sahBlockSize, size_t minLeafSize, size_t maxLeafSize, float travCost, float intCost, size_t singleThreadThreshold, size_t primrefarrayalloc = inf)
         : branchingFactor(2), maxDepth(32), logBlockSize(bsr(sahBlockSize)), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize),
-          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold), primrefarrayalloc(primrefarrayalloc) {}
+          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold), primrefarrayalloc(primrefarrayalloc), stats(nullptr), splitTask(BuildStatistics::BINNING) {}
 
       public:
         size_t branchingFactor;  //!< branching factor of BVH to build
@@ -76,6 +77,8 @@ namespace embree
         float intCost;           //!< estimated cost of one primitive intersection
         size_t singleThreadThreshold; //!< threshold when we switch to single threaded build
         size_t primrefarrayalloc;  //!< builder uses prim ref array to allocate nodes and leaves when a subtree of that size is finished
+        BuildStatistics* stats;  //!< optional statistics that gather the time spent finding splits and creating leaves
+        BuildStatistics::Task splitTask; //!< statistics task finding and performing splits gets accounted to
       };
 
       /*! recursive state of builder */
@@ -213,7 +216,9 @@ namespace embree
               progressMonitor(current.size());
 
             /*! find best split */
+            BuildStatistics::TaskTimer splitTimer(cfg.stats,cfg.splitTask);
             auto split = heuristic.find(current.prims,cfg.logBlockSize);
+            splitTimer.stop();
 
             /*! compute leaf and split cost */
             const float leafSAH  = cfg.intCost*current.prims.leafSAH(cfg.logBlockSize);
@@ -222,11 +227,13 @@ namespace embree
 
             /*! create a leaf node when threshold reached or SAH tells us to stop */
             if (current.prims.size() <= cfg.minLeafSize || current.depth+MIN_LARGE_LEAF_LEVELS >= cfg.maxDepth || (current.prims.size() <= cfg.maxLeafSize && leafSAH <= splitSAH)) {
+              BuildStatistics::TaskTimer leafTimer(cfg.stats,BuildStatistics::LEAVES);
               heuristic.deterministic_order(current.prims);
               return createLargeLeaf(current,alloc);
             }
 
             /*! perform initial split */
+            splitTimer.start();
             Set lprims,rprims;
             heuristic.split(split,current.prims,lprims,rprims);
 
@@ -266,6 +273,7 @@ namespace embree
               children[numChildren] = rrecord;
               numChildren++;
             }
+            splitTimer.stop();
 
             /* set barrier for primrefarrayalloc */
             if (unlikely(current.size() > cfg.primrefarrayalloc))
@@ -23,21 +23,26 @@ namespace embree
 {
   namespace isa
   {
-    PrimInfo createPrimRefArray(Geometry* geometry, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
+    PrimInfo createPrimRefArray(Geometry* geometry, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor) {
+      return createPrimRefArray(geometry,range<size_t>(0,geometry->size()),prims,progressMonitor);
+    }
+
+    PrimInfo createPrimRefArray(Geometry* geometry, const range<size_t>& r0, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
+      BuildStatistics::PhaseTimer timer(&geometry->scene->buildStats,BuildStatistics::PRIMREFS);
       ParallelPrefixSumState<PrimInfo> pstate;
       
       /* first try */
       progressMonitor(0);
-      PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
-          return geometry->createPrimRefArray(prims,r,r.begin());
+      PrimInfo pinfo = parallel_prefix_sum( pstate, r0.begin(), r0.end(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+          return geometry->createPrimRefArray(prims,r,r.begin()-r0.begin());
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 
       /* if we need to filter out geometry, run again */
-      if (pinfo.size() != prims.size())
+      if (pinfo.size() != r0.size())
       {
         progressMonitor(0);
-        pinfo = parallel_prefix_sum( pstate, size_t(0), geometry->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
+        pinfo = parallel_prefix_sum( pstate, r0.begin(), r0.end(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo {
           return geometry->createPrimRefArray(prims,r,base.size());
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       }
@@ -46,6 +51,7 @@ namespace embree
 
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
+      BuildStatistics::PhaseTimer timer(&scene->buildStats,BuildStatistics::PRIMREFS);
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator2 iter(scene,types,mblur);
       
@@ -69,6 +75,7 @@ namespace embree
 
     PrimInfo createPrimRefArrayMBlur(Scene* scene, Geometry::GTypeMask types, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor, size_t itime)
     {
+      BuildStatistics::PhaseTimer timer(&scene->buildStats,BuildStatistics::PRIMREFS);
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator2 iter(scene,types,true);
       
@@ -92,6 +99,7 @@ namespace embree
 
     PrimInfoMB createPrimRefArrayMSMBlur(Scene* scene, Geometry::GTypeMask types, mvector<PrimRefMB>& prims, BuildProgressMonitor& progressMonitor, BBox1f t0t1)
     {
+      BuildStatistics::PhaseTimer timer(&scene->buildStats,BuildStatistics::PRIMREFS);
       ParallelForForPrefixSumState<PrimInfoMB> pstate;
       Scene::Iterator2 iter(scene,types,true);
       
@@ -117,6 +125,7 @@ namespace embree
     template<typename Mesh>
     size_t createMortonCodeArray(Mesh* mesh, mvector<BVHBuilderMorton::BuildPrim>& morton, BuildProgressMonitor& progressMonitor)
     {
+      BuildStatistics::PhaseTimer timer(&mesh->scene->buildStats,BuildStatistics::PRIMREFS);
       size_t numPrimitives = morton.size();
 
       /* compute scene bounds */
@@ -27,6 +27,9 @@ namespace embree
   namespace isa
   {
     PrimInfo createPrimRefArray(Geometry* geometry, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+
+    /*! creates primrefs for the primitive range r of the geometry at the beginning of the prims array */
+    PrimInfo createPrimRefArray(Geometry* geometry, const range<size_t>& r, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
    
     PrimInfo createPrimRefArray(Scene* scene, Geometry::GTypeMask types, bool mblur, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
    
@@ -39,6 +39,7 @@ namespace embree
   {
     set(BVHN::emptyNode,empty,0);
     alloc.clear();
+    file = nullptr;
   }
 
   template<int N>
@@ -61,6 +62,137 @@ namespace embree
     }
   }
 
+  /*! header of a BVH stored in a file */
+  struct BVHFileHeader
+  {
+    char primTy[32];       //!< name of primitive type
+    size_t N;              //!< BVH width
+    LBBox3fa bounds;       //!< bounds of the BVH
+    size_t numPrimitives;  //!< number of primitives
+    size_t root;           //!< root node as offset into node data
+    size_t bytes;          //!< number of bytes of node data
+  };
+
+  template<int N>
+  void BVHN<N>::save(std::ostream& out) const
+  {
+    /* leaves of these primitive types store pointers */
+    const std::string name = primTy->name();
+    if (root != emptyNode && (name == "instance" || name == "subdivpatch1"))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH"+toString(N)+"<"+name+"> cannot get saved");
+
+    std::vector<char> data;
+    const NodeRef root = saveRecursion(this->root,data);
+
+    BVHFileHeader header;
+    memset(&header,0,sizeof(header));
+    strncpy(header.primTy,primTy->name(),sizeof(header.primTy)-1);
+    header.N = N;
+    header.bounds = bounds;
+    header.numPrimitives = numPrimitives;
+    header.root = root;
+    header.bytes = data.size();
+    AccelFile::write(out,&header,sizeof(header));
+    AccelFile::write(out,data.data(),data.size());
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::saveRecursion(NodeRef node, std::vector<char>& data) const
+  {
+    const size_t alignment = AccelFile::chunkAlignment;
+    
+    if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      if (num == 0) return node;
+
+      const char* end = prims;
+      for (size_t i=0; i<num; i++)
+        end += primTy->getBytes(end);
+
+      const size_t offset = data.size();
+      data.resize(offset+((end-prims+alignment-1) & ~(alignment-1)));
+      memcpy(&data[offset],prims,end-prims);
+      return NodeRef(offset | node.type());
+    }
+
+    size_t bytes = 0;
+    switch (node.type()) {
+    case tyAlignedNode     : bytes = sizeof(AlignedNode); break;
+    case tyAlignedNodeMB   : bytes = sizeof(AlignedNodeMB); break;
+    case tyAlignedNodeMB4D : bytes = sizeof(AlignedNodeMB4D); break;
+    case tyUnalignedNode   : bytes = sizeof(UnalignedNode); break;
+    case tyUnalignedNodeMB : bytes = sizeof(UnalignedNodeMB); break;
+    case tyQuantizedNode   : bytes = sizeof(QuantizedNode); break;
+    default: throw_RTCError(RTC_ERROR_INVALID_OPERATION,"unsupported BVH node type");
+    }
+
+    const size_t offset = data.size();
+    data.resize(offset+((bytes+alignment-1) & ~(alignment-1)));
+    memcpy(&data[offset],node.baseNode(BVH_FLAG_ALIGNED_NODE),bytes);
+
+    /* data gets reallocated while processing children */
+    for (size_t i=0; i<N; i++) {
+      const NodeRef child = saveRecursion(node.baseNode(BVH_FLAG_ALIGNED_NODE)->child(i),data);
+      ((BaseNode*)&data[offset])->child(i) = child;
+    }
+    return NodeRef(offset | node.type());
+  }
+
+  template<int N>
+  void BVHN<N>::load(AccelFile* file)
+  {
+    const BVHFileHeader* header = (const BVHFileHeader*) file->next(sizeof(BVHFileHeader));
+    if (header->N != N || strncmp(header->primTy,primTy->name(),sizeof(header->primTy)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure file does not match scene");
+
+    char* data = file->next(header->bytes);
+    NodeRef root(header->root);
+    loadRecursion(root,data,header->bytes);
+
+    set(root,header->bounds,header->numPrimitives);
+    this->file = file;
+  }
+
+  template<int N>
+  void BVHN<N>::loadRecursion(NodeRef& node, char* data, size_t bytes)
+  {
+    const size_t offset = size_t(node) & ~align_mask;
+    
+    if (node.isLeaf())
+    {
+      size_t num; node.leaf(num);
+      if (num == 0) return;
+
+      size_t end = offset;
+      for (size_t i=0; i<num; i++) {
+        if (end >= bytes) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"corrupted acceleration structure file");
+        end += primTy->getBytes(data+end);
+      }
+      if (end > bytes) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"corrupted acceleration structure file");
+      node = NodeRef(size_t(data) + size_t(node));
+      return;
+    }
+
+    size_t nodeBytes = 0;
+    switch (node.type()) {
+    case tyAlignedNode     : nodeBytes = sizeof(AlignedNode); break;
+    case tyAlignedNodeMB   : nodeBytes = sizeof(AlignedNodeMB); break;
+    case tyAlignedNodeMB4D : nodeBytes = sizeof(AlignedNodeMB4D); break;
+    case tyUnalignedNode   : nodeBytes = sizeof(UnalignedNode); break;
+    case tyUnalignedNodeMB : nodeBytes = sizeof(UnalignedNodeMB); break;
+    case tyQuantizedNode   : nodeBytes = sizeof(QuantizedNode); break;
+    default: throw_RTCError(RTC_ERROR_INVALID_OPERATION,"corrupted acceleration structure file");
+    }
+    if (offset >= bytes || nodeBytes > bytes-offset)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"corrupted acceleration structure file");
+
+    node = NodeRef(size_t(data) + size_t(node));
+    BaseNode* n = node.baseNode(BVH_FLAG_ALIGNED_NODE);
+    for (size_t i=0; i<N; i++)
+      loadRecursion(n->child(i),data,bytes);
+  }
+
   template<int N>
   void BVHN<N>::layoutLargeNodes(size_t num)
   {
@@ -122,6 +254,67 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  BVHN<N>* BVHN<N>::replicate()
+  {
+    BVHN* replica = new BVHN(*primTy,scene);
+    replica->alloc.init_estimate(replicateBytes(this->root));
+    const NodeRef root = replicateRecursion(this->root,replica->alloc.getCachedAllocator());
+    replica->set(root,bounds,numPrimitives);
+    replica->numVertices = numVertices;
+    replica->alloc.cleanup();
+    return replica;
+  }
+
+  template<int N>
+  size_t BVHN<N>::replicateBytes(NodeRef node) const
+  {
+    size_t bytes = 0;
+    if (node.isAlignedNode()) bytes = sizeof(AlignedNode);
+    else if (node.isAlignedNodeMB()) bytes = sizeof(AlignedNodeMB);
+    else return 0;
+
+    const BaseNode* n = node.baseNode(BVH_FLAG_ALIGNED_NODE | BVH_FLAG_ALIGNED_NODE_MB);
+    for (size_t c=0; c<N; c++)
+      bytes += replicateBytes(n->child(c));
+    return bytes;
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::replicateRecursion(NodeRef node, const FastAllocator::CachedAllocator& allocator)
+  {
+    /* other node types and leaves are shared with the original BVH */
+    if (node.isAlignedNode()) 
+    {
+      AlignedNode* oldnode = node.alignedNode();
+      AlignedNode* newnode = (BVHN::AlignedNode*) allocator.malloc0(sizeof(BVHN::AlignedNode),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator);
+      return encodeNode(newnode);
+    }
+    else if (node.isAlignedNodeMB()) 
+    {
+      AlignedNodeMB* oldnode = node.alignedNodeMB();
+      AlignedNodeMB* newnode = (BVHN::AlignedNodeMB*) allocator.malloc0(sizeof(BVHN::AlignedNodeMB),byteNodeAlignment);
+      *newnode = *oldnode;
+      for (size_t c=0; c<N; c++)
+        newnode->child(c) = replicateRecursion(oldnode->child(c),allocator);
+      return encodeNode(newnode);
+    }
+    else return node;
+  }
+
+  template<int N>
+  void BVHN<N>::addMemoryUsage(size_t& bytesAllocated, size_t& bytesUsed)
+  {
+    const FastAllocator::Statistics stat = alloc.getStatistics(FastAllocator::ANY_TYPE);
+    bytesAllocated += stat.bytesAllocatedTotal() + subdiv_patches.size();
+    bytesUsed      += stat.bytesUsed + subdiv_patches.size();
+    for (size_t i=0; i<objects.size(); i++)
+      if (objects[i]) objects[i]->addMemoryUsage(bytesAllocated,bytesUsed);
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
@@ -1439,10 +1439,31 @@ namespace embree
     /*! Clears the barrier bits of a subtree. */
     void clearBarrier(NodeRef& node);
 
+    /*! writes the BVH in a relocatable format */
+    void save(std::ostream& out) const;
+    NodeRef saveRecursion(NodeRef node, std::vector<char>& data) const;
+
+    /*! uses the BVH of some file in place */
+    void load(AccelFile* file);
+    void loadRecursion(NodeRef& node, char* data, size_t bytes);
+
     /*! lays out num large nodes of the BVH */
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
 
+    /*! copies all inner nodes into memory local to the calling thread, leaves are shared */
+    BVHN* replicate();
+    size_t replicateBytes(NodeRef node) const;
+    NodeRef replicateRecursion(NodeRef node, const FastAllocator::CachedAllocator& allocator);
+
+    /*! adds the bytes allocated and used by this BVH and its objects */
+    void addMemoryUsage(size_t& bytesAllocated, size_t& bytesUsed);
+
+    /*! returns the build statistics of the scene the BVH belongs to */
+    BuildStatistics* buildStats() {
+      return scene ? &scene->buildStats : nullptr;
+    }
+
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
 
@@ -1532,6 +1553,7 @@ namespace embree
     Scene* scene;                      //!< scene pointer
     NodeRef root;                      //!< root node
     FastAllocator alloc;               //!< allocator used to allocate nodes
+    Ref<AccelFile> file;               //!< file the BVH got loaded from
 
     /*! statistics data */
   public:
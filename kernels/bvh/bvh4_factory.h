@@ -100,6 +100,9 @@ namespace embree
     static void createTriangleMeshTriangle4Morton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4vMorton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4iMorton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createTriangleMeshTriangle4PLOC(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createTriangleMeshTriangle4vPLOC(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createTriangleMeshTriangle4iPLOC(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4v(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4i(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
@@ -170,6 +173,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Quad4iMBIntersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4Quad4iMBIntersector4HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH4Triangle4iIntersector4HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH4Quad4iIntersector4HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4SubdivPatch1Intersector4);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH4SubdivPatch1MBIntersector4);
 
@@ -208,6 +214,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Quad4iMBIntersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4Quad4iMBIntersector8HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH4Triangle4iIntersector8HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH4Quad4iIntersector8HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4SubdivPatch1Intersector8);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH4SubdivPatch1MBIntersector8);
 
@@ -246,6 +255,9 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Quad4iMBIntersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4Quad4iMBIntersector16HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH4Triangle4iIntersector16HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH4Quad4iIntersector16HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4SubdivPatch1Intersector16);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH4SubdivPatch1MBIntersector16);
 
@@ -348,5 +360,11 @@ namespace embree
     DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4iMeshBuilderMortonGeneral,void* COMMA TriangleMesh* COMMA size_t)
     DEFINE_ISA_FUNCTION(Builder*,BVH4Quad4vMeshBuilderMortonGeneral,void* COMMA QuadMesh* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH4VirtualMeshBuilderMortonGeneral,void* COMMA UserGeometry* COMMA size_t);
+
+    // PLOC mesh builders
+  private:
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4MeshBuilderPLOCGeneral,void* COMMA TriangleMesh* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4vMeshBuilderPLOCGeneral,void* COMMA TriangleMesh* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH4Triangle4iMeshBuilderPLOCGeneral,void* COMMA TriangleMesh* COMMA size_t);
   };
 }
@@ -99,6 +99,10 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridPluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4iIntersector4HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4Intersector4HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector4,QBVH8Quad4iIntersector4HybridPluecker);
+
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8VirtualIntersector4Chunk);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8VirtualMBIntersector4Chunk);
 
@@ -130,6 +134,10 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridPluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4iIntersector8HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4Intersector8HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector8,QBVH8Quad4iIntersector8HybridPluecker);
+
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8VirtualIntersector8Chunk);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8VirtualMBIntersector8Chunk);
 
@@ -161,6 +169,10 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridPluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4iIntersector16HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4Intersector16HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector16,QBVH8Quad4iIntersector16HybridPluecker);
+
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8VirtualIntersector16Chunk);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8VirtualMBIntersector16Chunk);
 
@@ -238,6 +250,9 @@ namespace embree
   DECLARE_ISA_FUNCTION(Builder*,BVH8Quad4vMeshBuilderMortonGeneral,void* COMMA QuadMesh* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8VirtualMeshBuilderMortonGeneral,void* COMMA UserGeometry* COMMA size_t);
 
+  DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4MeshBuilderPLOCGeneral,void* COMMA TriangleMesh* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH8Quad4vMeshBuilderPLOCGeneral,void* COMMA QuadMesh* COMMA size_t);
+
   BVH8Factory::BVH8Factory(int bfeatures, int ifeatures)
   {
     selectBuilders(bfeatures);
@@ -296,6 +311,9 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4iMeshBuilderMortonGeneral));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4vMeshBuilderMortonGeneral));
     IF_ENABLED_USER (SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8VirtualMeshBuilderMortonGeneral));
+
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4MeshBuilderPLOCGeneral));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Quad4vMeshBuilderPLOCGeneral));
   }
 
   void BVH8Factory::selectIntersectors(int features)
@@ -364,6 +382,10 @@ namespace embree
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector4HybridMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector4HybridPluecker));
 
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Triangle4iIntersector4HybridPluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Triangle4Intersector4HybridMoeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Quad4iIntersector4HybridPluecker));
+
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualIntersector4Chunk));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualMBIntersector4Chunk));
 
@@ -396,6 +418,10 @@ namespace embree
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector8HybridMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector8HybridPluecker));
 
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Triangle4iIntersector8HybridPluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Triangle4Intersector8HybridMoeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Quad4iIntersector8HybridPluecker));
+
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualIntersector8Chunk));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualMBIntersector8Chunk));
 
@@ -428,6 +454,10 @@ namespace embree
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8Quad4iMBIntersector16HybridMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8Quad4iMBIntersector16HybridPluecker));
 
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,QBVH8Triangle4iIntersector16HybridPluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,QBVH8Triangle4Intersector16HybridMoeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,QBVH8Quad4iIntersector16HybridPluecker));
+
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8VirtualIntersector16Chunk));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8VirtualMBIntersector16Chunk));
 
@@ -481,6 +511,13 @@ namespace embree
     builder = factory->BVH8Triangle4iMeshBuilderMortonGeneral(accel,mesh,0);
   }
 
+  void BVH8Factory::createTriangleMeshTriangle4PLOC(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    BVH8Factory* factory = mesh->scene->device->bvh8_factory.get();
+    accel = new BVH8(Triangle4::type,mesh->scene);
+    builder = factory->BVH8Triangle4MeshBuilderPLOCGeneral(accel,mesh,0);
+  }
+
   void BVH8Factory::createTriangleMeshTriangle4(TriangleMesh* mesh, AccelData*& accel, Builder*& builder)
   {
     BVH8Factory* factory = mesh->scene->device->bvh8_factory.get();
@@ -540,6 +577,13 @@ namespace embree
     builder = factory->BVH8Quad4vMeshBuilderMortonGeneral(accel,mesh,0);
   }
 
+  void BVH8Factory::createQuadMeshQuad4vPLOC(QuadMesh* mesh, AccelData*& accel, Builder*& builder)
+  {
+    BVH8Factory* factory = mesh->scene->device->bvh8_factory.get();
+    accel = new BVH8(Quad4v::type,mesh->scene);
+    builder = factory->BVH8Quad4vMeshBuilderPLOCGeneral(accel,mesh,0);
+  }
+
   void BVH8Factory::createUserGeometryMesh(UserGeometry* mesh, AccelData*& accel, Builder*& builder)
   {
     BVH8Factory* factory = mesh->scene->device->bvh8_factory.get();
@@ -815,6 +859,12 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1 = QBVH8Triangle4iIntersector1Pluecker();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4 = QBVH8Triangle4iIntersector4HybridPluecker();
+    intersectors.intersector8 = QBVH8Triangle4iIntersector8HybridPluecker();
+    intersectors.intersector16= QBVH8Triangle4iIntersector16HybridPluecker();
+    intersectors.intersectorN = BVH8IntersectorStreamPacketFallback();
+#endif
     return intersectors;
   }
 
@@ -823,6 +873,12 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1 = QBVH8Triangle4Intersector1Moeller();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4 = QBVH8Triangle4Intersector4HybridMoeller();
+    intersectors.intersector8 = QBVH8Triangle4Intersector8HybridMoeller();
+    intersectors.intersector16= QBVH8Triangle4Intersector16HybridMoeller();
+    intersectors.intersectorN = BVH8IntersectorStreamPacketFallback();
+#endif
     return intersectors;
   }
 
@@ -831,6 +887,12 @@ namespace embree
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
     intersectors.intersector1 = QBVH8Quad4iIntersector1Pluecker();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4 = QBVH8Quad4iIntersector4HybridPluecker();
+    intersectors.intersector8 = QBVH8Quad4iIntersector8HybridPluecker();
+    intersectors.intersector16= QBVH8Quad4iIntersector16HybridPluecker();
+    intersectors.intersectorN = BVH8IntersectorStreamPacketFallback();
+#endif
     return intersectors;
   }
 
@@ -915,6 +977,7 @@ namespace embree
     else if (scene->device->tri_builder == "sah_presplit")     builder = BVH8Triangle4SceneBuilderSAH(accel,scene,MODE_HIGH_QUALITY);
     else if (scene->device->tri_builder == "dynamic"     ) builder = BVH8BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4);
     else if (scene->device->tri_builder == "morton"     ) builder = BVH8BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4Morton);
+    else if (scene->device->tri_builder == "ploc"       ) builder = BVH8BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4PLOC);
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH8<Triangle4>");
 
     return new AccelInstance(accel,builder,intersectors);
@@ -1024,6 +1087,7 @@ namespace embree
     }
     else if (scene->device->quad_builder == "dynamic"      ) builder = BVH8BuilderTwoLevelQuadMeshSAH(accel,scene,&createQuadMeshQuad4v);
     else if (scene->device->quad_builder == "morton"       ) builder = BVH8BuilderTwoLevelQuadMeshSAH(accel,scene,&createQuadMeshQuad4vMorton);
+    else if (scene->device->quad_builder == "ploc"         ) builder = BVH8BuilderTwoLevelQuadMeshSAH(accel,scene,&createQuadMeshQuad4vPLOC);
     else if (scene->device->quad_builder == "sah_fast_spatial" ) builder = BVH8Quad4vSceneBuilderFastSpatialSAH(accel,scene,0);
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder+" for BVH8<Quad4v>");
 
@@ -1176,7 +1240,7 @@ namespace embree
 
   Accel* BVH8Factory::BVH8GridMB(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
-    BVH8* accel = new BVH8(SubGridQBVH8::type,scene);
+    BVH8* accel = new BVH8(SubGridMBQBVH8::type,scene);
     Accel::Intersectors intersectors = BVH8GridMBIntersectors(accel,ivariant);
     Builder* builder = nullptr;
     if (scene->device->grid_builder_mb == "default") {
@@ -56,11 +56,13 @@ namespace embree
     static void createTriangleMeshTriangle4Morton (TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4vMorton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4iMorton(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createTriangleMeshTriangle4PLOC   (TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4 (TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4v(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createTriangleMeshTriangle4i(TriangleMesh* mesh, AccelData*& accel, Builder*& builder);
 
     static void createQuadMeshQuad4vMorton(QuadMesh* mesh, AccelData*& accel, Builder*& builder);
+    static void createQuadMeshQuad4vPLOC(QuadMesh* mesh, AccelData*& accel, Builder*& builder);
     static void createQuadMeshQuad4v(QuadMesh* mesh, AccelData*& accel, Builder*& builder);
 
     static void createUserGeometryMesh(UserGeometry* mesh, AccelData*& accel, Builder*& builder);
@@ -154,6 +156,10 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4iIntersector4HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4Intersector4HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector4,QBVH8Quad4iIntersector4HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8VirtualIntersector4Chunk);
     DEFINE_SYMBOL2(Accel::Intersector4,BVH8VirtualMBIntersector4Chunk);
 
@@ -185,6 +191,10 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4iIntersector8HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4Intersector8HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector8,QBVH8Quad4iIntersector8HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8VirtualIntersector8Chunk);
     DEFINE_SYMBOL2(Accel::Intersector8,BVH8VirtualMBIntersector8Chunk);
 
@@ -216,6 +226,10 @@ namespace embree
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridMoeller);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridPluecker);
 
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4iIntersector16HybridPluecker);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4Intersector16HybridMoeller);
+    DEFINE_SYMBOL2(Accel::Intersector16,QBVH8Quad4iIntersector16HybridPluecker);
+
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8VirtualIntersector16Chunk);
     DEFINE_SYMBOL2(Accel::Intersector16,BVH8VirtualMBIntersector16Chunk);
 
@@ -305,5 +319,10 @@ namespace embree
     DEFINE_ISA_FUNCTION(Builder*,BVH8Triangle4iMeshBuilderMortonGeneral,void* COMMA TriangleMesh* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH8Quad4vMeshBuilderMortonGeneral,void* COMMA QuadMesh* COMMA size_t);
     DEFINE_ISA_FUNCTION(Builder*,BVH8VirtualMeshBuilderMortonGeneral,void* COMMA UserGeometry* COMMA size_t);
+
+    // PLOC mesh builders
+  private:
+    DEFINE_ISA_FUNCTION(Builder*,BVH8Triangle4MeshBuilderPLOCGeneral,void* COMMA TriangleMesh* COMMA size_t);
+    DEFINE_ISA_FUNCTION(Builder*,BVH8Quad4vMeshBuilderPLOCGeneral,void* COMMA QuadMesh* COMMA size_t);
   };
 }
@@ -18,6 +18,7 @@
 #include "../builders/primrefgen.h"
 
 #include "../geometry/linei.h"
+#include "../geometry/pointi.h"
 #include "../geometry/curveNi.h"
 #include "../geometry/curveNv.h"
 
@@ -27,7 +28,7 @@ namespace embree
 {
   namespace isa
   {
-    template<int N, typename CurvePrimitive, typename LinePrimitive>
+    template<int N, typename CurvePrimitive, typename LinePrimitive, typename PointPrimitive>
     struct BVHNHairBuilderSAH : public Builder
     {
       typedef BVHN<N> BVH;
@@ -40,6 +41,27 @@ namespace embree
 
       BVHNHairBuilderSAH (BVH* bvh, Scene* scene)
         : bvh(bvh), scene(scene), prims(scene->device,0) {}
+
+      /* subtree size below which the BVH gets allocated inside the primref array */
+      __forceinline size_t finishedRangeThreshold(size_t numPrimitives) const
+      {
+        if (scene->isLowMemoryBuild())
+          return max(numPrimitives/1000,size_t(1000));
+        if (numPrimitives/1000 >= 1000)
+          return numPrimitives/1000;
+        return inf;
+      }
+
+      size_t estimateMemory()
+      {
+        const size_t numPrimitives = scene->getNumPrimitives<CurveGeometry,false>();
+        const size_t prim_bytes = numPrimitives*sizeof(PrimRef);
+        const size_t node_bytes = numPrimitives*sizeof(typename BVH::UnalignedNode)/(4*N);
+        const size_t leaf_bytes = CurvePrimitive::bytes(numPrimitives);
+        if (finishedRangeThreshold(numPrimitives) < numPrimitives)
+          return max(prim_bytes,node_bytes+leaf_bytes);
+        return prim_bytes+node_bytes+leaf_bytes;
+      }
       
       void build() 
       {
@@ -59,7 +81,7 @@ namespace embree
 
         /* create primref array */
         prims.resize(numPrimitives);
-        const PrimInfo pinfo = createPrimRefArray(scene,Geometry::MTY_CURVES,false,prims,scene->progressInterface);
+        const PrimInfo pinfo = createPrimRefArray(scene,Geometry::GTypeMask(Geometry::MTY_CURVES | Geometry::MTY_POINTS),false,prims,scene->progressInterface);
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.size()*sizeof(typename BVH::UnalignedNode)/(4*N);
@@ -72,9 +94,7 @@ namespace embree
         settings.logBlockSize = bsf(CurvePrimitive::max_size());
         settings.minLeafSize = CurvePrimitive::max_size();
         settings.maxLeafSize = CurvePrimitive::max_size();
-        settings.finished_range_threshold = numPrimitives/1000;
-        if (settings.finished_range_threshold < 1000)
-          settings.finished_range_threshold = inf;
+        settings.finished_range_threshold = finishedRangeThreshold(numPrimitives);
 
         /* creates a leaf node */
         auto createLeaf = [&] (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
@@ -83,7 +103,9 @@ namespace embree
             return BVH::emptyNode;
 
           const unsigned int geomID0 = prims[set.begin()].geomID();
-          if (scene->get(geomID0)->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
+          if (scene->get(geomID0)->getTypeMask() & Geometry::MTY_POINTS)
+            return PointPrimitive::createLeaf(bvh,prims,set,alloc);
+          else if (scene->get(geomID0)->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
             return LinePrimitive::createLeaf(bvh,prims,set,alloc);
           else
             return CurvePrimitive::createLeaf(bvh,prims,set,alloc);
@@ -98,6 +120,7 @@ namespace embree
           };
           
         /* build hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         typename BVH::NodeRef root = BVHBuilderHair::build<NodeRef>
           (typename BVH::CreateAlloc(bvh),
            typename BVH::AlignedNode::Create(),
@@ -107,6 +130,7 @@ namespace embree
            createLeaf,scene->progressInterface,
            reportFinishedRange,
            scene,prims.data(),pinfo,settings);
+        hierarchyTimer.stop();
         
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         /* if we allocated using the primrefarray we have to keep it alive */
@@ -128,12 +152,12 @@ namespace embree
     };
     
     /*! entry functions for the builder */
-    Builder* BVH4Curve4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4v,Line4i>((BVH4*)bvh,scene); }
-    Builder* BVH4Curve4iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i>((BVH4*)bvh,scene); }
+    Builder* BVH4Curve4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4v,Line4i,Point4i>((BVH4*)bvh,scene); }
+    Builder* BVH4Curve4iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve4i,Line4i,Point4i>((BVH4*)bvh,scene); }
 
 #if defined(__AVX__)
-    Builder* BVH8Curve8vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Curve8v,Line8i>((BVH8*)bvh,scene); }
-    Builder* BVH4Curve8iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve8i,Line8i>((BVH4*)bvh,scene); }
+    Builder* BVH8Curve8vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Curve8v,Line8i,Point8i>((BVH8*)bvh,scene); }
+    Builder* BVH4Curve8iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Curve8i,Line8i,Point8i>((BVH4*)bvh,scene); }
 #endif
 
   }
@@ -18,6 +18,7 @@
 #include "../builders/primrefgen.h"
 
 #include "../geometry/linei.h"
+#include "../geometry/pointi.h"
 #include "../geometry/curveNi_mb.h"
 
 #if defined(EMBREE_GEOMETRY_CURVE)
@@ -27,7 +28,7 @@ namespace embree
   namespace isa
   {
     /* FIXME: add fast path for single-segment motion blur */
-    template<int N, typename CurvePrimitive, typename LinePrimitive>
+    template<int N, typename CurvePrimitive, typename LinePrimitive, typename PointPrimitive>
     struct BVHNHairMBlurBuilderSAH : public Builder
     {
       typedef BVHN<N> BVH;
@@ -39,6 +40,19 @@ namespace embree
 
       BVHNHairMBlurBuilderSAH (BVH* bvh, Scene* scene)
         : bvh(bvh), scene(scene) {}
+
+      size_t estimateMemory()
+      {
+        const size_t numPrimitives = scene->getNumPrimitives<CurveGeometry,true>();
+        if (numPrimitives == 0) return 0;
+
+        /* assumes that each primitive spans all time segments */
+        const size_t numTimeSegments = max(scene->getNumTimeSteps<CurveGeometry,true>(),2u)-1;
+        const size_t prim_bytes = numPrimitives*sizeof(PrimRefMB);
+        const size_t node_bytes = numTimeSegments*numPrimitives*sizeof(typename BVH::AlignedNodeMB)/(4*N);
+        const size_t leaf_bytes = CurvePrimitive::bytes(numTimeSegments*numPrimitives);
+        return prim_bytes+node_bytes+leaf_bytes;
+      }
       
       void build() 
       {
@@ -55,7 +69,7 @@ namespace embree
 
         /* create primref array */
         mvector<PrimRefMB> prims0(scene->device,numPrimitives);
-        const PrimInfoMB pinfo = createPrimRefArrayMSMBlur(scene,Geometry::MTY_CURVES,prims0,bvh->scene->progressInterface);
+        const PrimInfoMB pinfo = createPrimRefArrayMSMBlur(scene,Geometry::GTypeMask(Geometry::MTY_CURVES | Geometry::MTY_POINTS),prims0,bvh->scene->progressInterface);
 
         /* estimate acceleration structure size */
         const size_t node_bytes = pinfo.num_time_segments*sizeof(typename BVH::AlignedNodeMB)/(4*N);
@@ -77,13 +91,16 @@ namespace embree
             return NodeRecordMB4D(BVH::emptyNode,empty,empty);
           
           const unsigned int geomID0 = (*prims.prims)[prims.object_range.begin()].geomID();
-          if (scene->get(geomID0)->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
+          if (scene->get(geomID0)->getTypeMask() & Geometry::MTY_POINTS)
+            return PointPrimitive::createLeafMB(bvh,prims,alloc);
+          else if (scene->get(geomID0)->getCurveBasis() == Geometry::GTY_BASIS_LINEAR)
             return LinePrimitive::createLeafMB(bvh,prims,alloc);
           else
             return CurvePrimitive::createLeafMB(bvh,prims,alloc);
         };
 
         /* build the hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         auto root = BVHBuilderHairMSMBlur::build<NodeRef>
           (scene, prims0, pinfo,
            VirtualRecalculatePrimRef(scene),
@@ -95,6 +112,7 @@ namespace embree
            createLeaf,
            bvh->scene->progressInterface,
            settings);
+        hierarchyTimer.stop();
         
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
         
@@ -111,10 +129,10 @@ namespace embree
     };
     
     /*! entry functions for the builder */
-    Builder* BVH4OBBCurve4iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve4iMB,Line4i>((BVH4*)bvh,scene); }
+    Builder* BVH4OBBCurve4iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve4iMB,Line4i,Point4i>((BVH4*)bvh,scene); }
 
 #if defined(__AVX__)
-    Builder* BVH4OBBCurve8iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve8iMB,Line8i>((BVH4*)bvh,scene); }
+    Builder* BVH4OBBCurve8iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve8iMB,Line8i,Point8i>((BVH4*)bvh,scene); }
 #endif
 
   }
@@ -22,6 +22,7 @@
 
 #include "../builders/primrefgen.h"
 #include "../builders/bvh_builder_morton.h"
+#include "../builders/bvh_builder_ploc.h"
 
 #include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
@@ -381,7 +382,7 @@ namespace embree
       Mesh* mesh;
     };        
 
-    template<int N, typename Mesh, typename Primitive>
+    template<int N, typename Mesh, typename Primitive, typename BVHBuilder = BVHBuilderMorton>
     class BVHNMeshBuilderMorton : public Builder
     {
       typedef BVHN<N> BVH;
@@ -393,10 +394,20 @@ namespace embree
       
       BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, const size_t minLeafSize, const size_t maxLeafSize, const size_t singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD)
         : bvh(bvh), mesh(mesh), morton(bvh->device,0), settings(N,BVH::maxBuildDepth,minLeafSize,maxLeafSize,singleThreadThreshold) {}
+
+      size_t estimateMemory()
+      {
+        const size_t numPrimitives = mesh->size();
+        const size_t bytesEstimated = numPrimitives*sizeof(AlignedNode)/(4*N) + size_t(1.2f*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        const size_t bytesMortonCodes = numPrimitives*sizeof(BVHBuilderMorton::BuildPrim);
+        return bytesMortonCodes + max(bytesEstimated,bytesMortonCodes);
+      }
       
       /* build function */
       void build() 
       {
+        const double t0 = getSeconds();
+
         /* we reset the allocator when the mesh size changed */
         if (mesh->numPrimitivesChanged) {
           bvh->alloc.clear();
@@ -425,11 +436,13 @@ namespace embree
         SetBVHNBounds<N> setBounds(bvh);
         CreateMortonLeaf<N,Primitive> createLeaf(mesh,morton.data());
         CalculateMeshBounds<Mesh> calculateBounds(mesh);
-        auto root = BVHBuilderMorton::build<NodeRecord>(
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
+        auto root = BVHBuilder::template build<NodeRecord>(
           typename BVH::CreateAlloc(bvh), 
           typename BVH::AlignedNode::Create(),
           setBounds,createLeaf,calculateBounds,bvh->scene->progressInterface,
           morton.data(),dest,numPrimitivesGen,settings);
+        hierarchyTimer.stop();
         
         bvh->set(root.ref,LBBox3fa(root.bounds),numPrimitives);
         
@@ -442,6 +455,11 @@ namespace embree
         }
 #endif
 
+        /* improve the SAH of the BVH using more tree rotations within the time budget */
+        const float budget = bvh->device->tree_rotation_budget;
+        if (budget > 0.0f)
+          BVHNRotate<N>::optimize(bvh,double(budget)*(getSeconds()-t0));
+
         /* clear temporary data for static geometry */
         if (bvh->scene->isStaticAccel()) 
         {
@@ -471,12 +489,20 @@ namespace embree
     Builder* BVH8Triangle4vMeshBuilderMortonGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<8,TriangleMesh,Triangle4v>((BVH8*)bvh,mesh,4,4); }
     Builder* BVH8Triangle4iMeshBuilderMortonGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<8,TriangleMesh,Triangle4i>((BVH8*)bvh,mesh,4,4); }
 #endif
+
+    Builder* BVH4Triangle4MeshBuilderPLOCGeneral  (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4, BVHBuilderPLOC>((BVH4*)bvh,mesh,4,4); }
+    Builder* BVH4Triangle4vMeshBuilderPLOCGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4v,BVHBuilderPLOC>((BVH4*)bvh,mesh,4,4); }
+    Builder* BVH4Triangle4iMeshBuilderPLOCGeneral (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,TriangleMesh,Triangle4i,BVHBuilderPLOC>((BVH4*)bvh,mesh,4,4); }
+#if defined(__AVX__)
+    Builder* BVH8Triangle4MeshBuilderPLOCGeneral  (void* bvh, TriangleMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<8,TriangleMesh,Triangle4, BVHBuilderPLOC>((BVH8*)bvh,mesh,4,4); }
+#endif
 #endif
 
 #if defined(EMBREE_GEOMETRY_QUAD)
     Builder* BVH4Quad4vMeshBuilderMortonGeneral (void* bvh, QuadMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<4,QuadMesh,Quad4v>((BVH4*)bvh,mesh,4,4); }
 #if defined(__AVX__)
     Builder* BVH8Quad4vMeshBuilderMortonGeneral (void* bvh, QuadMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<8,QuadMesh,Quad4v>((BVH8*)bvh,mesh,4,4); }
+    Builder* BVH8Quad4vMeshBuilderPLOCGeneral   (void* bvh, QuadMesh* mesh, size_t mode) { return new class BVHNMeshBuilderMorton<8,QuadMesh,Quad4v,BVHBuilderPLOC>((BVH8*)bvh,mesh,4,4); }
 #endif
 #endif
 
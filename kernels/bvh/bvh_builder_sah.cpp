@@ -106,18 +106,127 @@ namespace embree
       Mesh* mesh;
       mvector<PrimRef> prims;
       GeneralBVHBuilder::Settings settings;
+      const size_t minLeafSize;
       bool primrefarrayalloc;
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize,
                       const size_t mode, bool primrefarrayalloc = false)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0),
-          settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), primrefarrayalloc(primrefarrayalloc) {}
+          settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), minLeafSize(minLeafSize), primrefarrayalloc(primrefarrayalloc) {}
 
       BVHNBuilderSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), primrefarrayalloc(false) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), minLeafSize(minLeafSize), primrefarrayalloc(false) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
+      /* estimated size of the BVH in the build mode selected by the memory budget */
+      __forceinline size_t bvhBytes(size_t numPrimitives) const
+      {
+        const size_t node_bytes = numPrimitives*sizeof(typename BVH::AlignedNodeMB)/(4*N*bvh->scene->leafSizeScale());
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        return node_bytes+leaf_bytes;
+      }
+
+      /* subtree size below which the BVH gets allocated inside the primref array */
+      __forceinline size_t primrefArrayAllocThreshold(size_t numPrimitives) const
+      {
+        if (scene && scene->isLowMemoryBuild())
+          return max(numPrimitives/1000,size_t(1000));
+        if (primrefarrayalloc && numPrimitives/1000 >= 1000)
+          return numPrimitives/1000;
+        return inf;
+      }
+
+      /* out-of-core builds stream the primitives of the scene in chunks */
+      __forceinline bool isOutOfCoreBuild(size_t numPrimitives) const {
+        return scene && scene->device->out_of_core_directory != "" && numPrimitives > scene->device->out_of_core_chunk_size;
+      }
+
+      size_t estimateMemory()
+      {
+        const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
+        if (isOutOfCoreBuild(numPrimitives))
+          return scene->device->out_of_core_chunk_size*sizeof(PrimRef)+bvhBytes(numPrimitives);
+
+        const size_t prim_bytes = numPrimitives*sizeof(PrimRef);
+        if (primrefArrayAllocThreshold(numPrimitives) < numPrimitives)
+          return max(prim_bytes,bvhBytes(numPrimitives));
+        return prim_bytes+bvhBytes(numPrimitives);
+      }
+
+      /* builds one sub-BVH per chunk of primitives into OS allocated blocks, which get backed by files
+         in out-of-core mode, and merges these sub-BVHs under a top-level BVH */
+      void buildOutOfCore(size_t numPrimitives)
+      {
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAHOutOfCore");
+
+        const size_t chunkSize = scene->device->out_of_core_chunk_size;
+        const size_t bytesEstimated = bvhBytes(numPrimitives);
+        bvh->alloc.setOSallocation(true);
+        bvh->alloc.init_estimate(bytesEstimated);
+        settings.primrefarrayalloc = inf;
+        settings.minLeafSize = min(minLeafSize*bvh->scene->leafSizeScale(),settings.maxLeafSize);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,chunkSize,bytesEstimated);
+        settings.stats = bvh->buildStats();
+        prims.resize(chunkSize);
+
+        /* build sub-BVHs chunk by chunk, only the primrefs of one chunk are in memory at a time */
+        avector<PrimRef> refs;
+        std::vector<NodeRef> roots;
+        PrimInfo rinfo(empty);
+        size_t numBuilt = 0;
+        BBox3fa bounds = empty;
+        Scene::Iterator2 iter(scene,Mesh::geom_type,false);
+        for (size_t i=0; i<iter.size(); i++)
+        {
+          Geometry* geom = iter.at(i);
+          if (geom == nullptr) continue;
+
+          for (size_t begin=0; begin<geom->size(); begin+=chunkSize)
+          {
+            const range<size_t> r(begin,min(begin+chunkSize,geom->size()));
+            const PrimInfo pinfo = createPrimRefArray(geom,r,prims,bvh->scene->progressInterface);
+            if (pinfo.size() == 0) continue;
+
+            BuildStatistics::PhaseTimer hierarchyTimer(settings.stats,BuildStatistics::HIERARCHY);
+            NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            hierarchyTimer.stop();
+            const PrimRef ref(pinfo.geomBounds,0,unsigned(roots.size()));
+            rinfo.add_center2(ref);
+            refs.push_back(ref);
+            roots.push_back(root);
+            numBuilt += pinfo.size();
+            bounds.extend(pinfo.geomBounds);
+          }
+        }
+        prims.clear();
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(roots.size() == 0)) {
+          bvh->clear();
+          return;
+        }
+
+        /* top-level BVH with one sub-BVH per leaf */
+        NodeRef root = roots[0];
+        if (roots.size() > 1)
+        {
+          BuildStatistics::PhaseTimer topLevelTimer(bvh->buildStats(),BuildStatistics::TOPLEVEL);
+          auto progress = BuildProgressMonitorFromClosure([&] (size_t dn) { bvh->scene->progressMonitor(0); });
+          GeneralBVHBuilder::Settings tsettings(1,1,1,travCost,1.0f,DEFAULT_SINGLE_THREAD_THRESHOLD);
+          root = BVHNBuilderVirtual<N>::build(&bvh->alloc,[&] (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
+              assert(set.size() == 1);
+              return roots[prims[set.begin()].primID()];
+            },progress,refs.data(),rinfo,tsettings);
+        }
+        bvh->set(root,LBBox3fa(bounds),numBuilt);
+        bvh->layoutLargeNodes(size_t(numBuilt*0.005f));
+        if (scene->isStaticAccel())
+          bvh->shrink();
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
       void build()
       {
         /* we reset the allocator when the mesh size changed */
@@ -137,6 +246,11 @@ namespace embree
           return;
         }
 
+        if (isOutOfCoreBuild(numPrimitives)) {
+          buildOutOfCore(numPrimitives);
+          return;
+        }
+
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
 #if PROFILE
@@ -144,21 +258,17 @@ namespace embree
 #endif
 
             /* create primref array */
-            if (primrefarrayalloc) {
-              settings.primrefarrayalloc = numPrimitives/1000;
-              if (settings.primrefarrayalloc < 1000)
-                settings.primrefarrayalloc = inf;
-            }
+            settings.primrefarrayalloc = primrefArrayAllocThreshold(numPrimitives);
+            settings.minLeafSize = min(minLeafSize*bvh->scene->leafSizeScale(),settings.maxLeafSize);
 
             /* enable os_malloc for two level build */
             if (mesh)
               bvh->alloc.setOSallocation(true);
 
             /* initialize allocator */
-            const size_t node_bytes = numPrimitives*sizeof(typename BVH::AlignedNodeMB)/(4*N);
-            const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
-            bvh->alloc.init_estimate(node_bytes+leaf_bytes);
-            settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            const size_t bytesEstimated = bvhBytes(numPrimitives);
+            bvh->alloc.init_estimate(bytesEstimated);
+            settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,bytesEstimated);
             prims.resize(numPrimitives); 
 
             PrimInfo pinfo = mesh ?
@@ -174,7 +284,10 @@ namespace embree
             }
 
             /* call BVH builder */
+            settings.stats = bvh->buildStats();
+            BuildStatistics::PhaseTimer hierarchyTimer(settings.stats,BuildStatistics::HIERARCHY);
             NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            hierarchyTimer.stop();
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
             bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
@@ -216,15 +329,30 @@ namespace embree
       Mesh* mesh;
       mvector<PrimRef> prims;
       GeneralBVHBuilder::Settings settings;
+      const size_t minLeafSize;
 
       BVHNBuilderSAHQuantized (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), minLeafSize(minLeafSize) {}
 
       BVHNBuilderSAHQuantized (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), minLeafSize(minLeafSize) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
+      /* estimated size of the BVH in the build mode selected by the memory budget */
+      __forceinline size_t bvhBytes(size_t numPrimitives) const
+      {
+        const size_t node_bytes = numPrimitives*sizeof(typename BVH::QuantizedNode)/(4*N*bvh->scene->leafSizeScale());
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        return node_bytes+leaf_bytes;
+      }
+
+      size_t estimateMemory()
+      {
+        const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
+        return numPrimitives*sizeof(PrimRef) + bvhBytes(numPrimitives);
+      }
+
       void build()
       {
         /* we reset the allocator when the mesh size changed */
@@ -256,11 +384,14 @@ namespace embree
               bvh->alloc.setOSallocation(true);
 
             /* call BVH builder */
-            const size_t node_bytes = numPrimitives*sizeof(typename BVH::QuantizedNode)/(4*N);
-            const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
-            bvh->alloc.init_estimate(node_bytes+leaf_bytes);
-            settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            const size_t bytesEstimated = bvhBytes(numPrimitives);
+            bvh->alloc.init_estimate(bytesEstimated);
+            settings.minLeafSize = min(minLeafSize*bvh->scene->leafSizeScale(),settings.maxLeafSize);
+            settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,bytesEstimated);
+            settings.stats = bvh->buildStats();
+            BuildStatistics::PhaseTimer hierarchyTimer(settings.stats,BuildStatistics::HIERARCHY);
             NodeRef root = BVHNBuilderQuantizedVirtual<N>::build(&bvh->alloc,CreateLeafQuantized<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+            hierarchyTimer.stop();
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
             //bvh->layoutLargeNodes(pinfo.size()*0.005f); // FIXME: COPY LAYOUT FOR LARGE NODES !!!
 #if PROFILE
@@ -496,11 +627,11 @@ namespace embree
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
         /* create primref array */
-        if (primrefarrayalloc) {
+        settings.primrefarrayalloc = inf;
+        if (scene && scene->isLowMemoryBuild())
+          settings.primrefarrayalloc = max(numPrimitives/1000,size_t(1000));
+        else if (primrefarrayalloc && numPrimitives/1000 >= 1000)
           settings.primrefarrayalloc = numPrimitives/1000;
-          if (settings.primrefarrayalloc < 1000)
-            settings.primrefarrayalloc = inf;
-        }
 
         /* enable os_malloc for two level build */
         if (mesh)
@@ -524,7 +655,10 @@ namespace embree
         }
 
         /* call BVH builder */
+        settings.stats = bvh->buildStats();
+        BuildStatistics::PhaseTimer hierarchyTimer(settings.stats,BuildStatistics::HIERARCHY);
         NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings);
+        hierarchyTimer.stop();
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
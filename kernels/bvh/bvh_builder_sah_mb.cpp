@@ -116,6 +116,19 @@ namespace embree
       BVHNBuilderMBlurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
         : bvh(bvh), scene(scene), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
 
+      size_t estimateMemory()
+      {
+        const size_t numPrimitives = scene->getNumPrimitives<Mesh,true>();
+        if (numPrimitives == 0) return 0;
+
+        /* assumes that each primitive spans all time segments */
+        const size_t numTimeSegments = max(scene->getNumTimeSteps<Mesh,true>(),2u)-1;
+        const size_t prim_bytes = numPrimitives*(numTimeSegments == 1 ? sizeof(PrimRef) : sizeof(PrimRefMB));
+        const size_t node_bytes = numTimeSegments*numPrimitives*sizeof(AlignedNodeMB)/(4*N*scene->leafSizeScale());
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numTimeSegments*numPrimitives)*sizeof(Primitive));
+        return prim_bytes+node_bytes+leaf_bytes;
+      }
+
       void build()
       {
 	/* skip build for empty scene */
@@ -163,17 +176,20 @@ namespace embree
         settings.branchingFactor = N;
         settings.maxDepth = BVH::maxBuildDepthLeaf;
         settings.logBlockSize = bsr(sahBlockSize);
-        settings.minLeafSize = minLeafSize;
+        settings.minLeafSize = min(minLeafSize*bvh->scene->leafSizeScale(),maxLeafSize);
         settings.maxLeafSize = maxLeafSize;
         settings.travCost = travCost;
         settings.intCost = intCost;
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+        settings.stats = bvh->buildStats();
 
         /* build hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         auto root = BVHBuilderBinnedSAH::build<NodeRecordMB>
           (typename BVH::CreateAlloc(bvh),typename BVH::AlignedNodeMB::Create2(),typename BVH::AlignedNodeMB::Set2(),
            CreateMBlurLeaf<N,Primitive>(bvh,prims.data(),0),bvh->scene->progressInterface,
            prims.data(),pinfo,settings);
+        hierarchyTimer.stop();
 
         bvh->set(root.ref,root.lbounds,pinfo.size());
       }
@@ -196,7 +212,7 @@ namespace embree
         settings.branchingFactor = N;
         settings.maxDepth = BVH::maxDepth;
         settings.logBlockSize = bsr(sahBlockSize);
-        settings.minLeafSize = minLeafSize;
+        settings.minLeafSize = min(minLeafSize*bvh->scene->leafSizeScale(),maxLeafSize);
         settings.maxLeafSize = maxLeafSize;
         settings.travCost = travCost;
         settings.intCost = intCost;
@@ -204,6 +220,7 @@ namespace embree
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
         
         /* build hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         auto root =
           BVHBuilderMSMBlur::build<NodeRef>(prims,pinfo,scene->device,
                                             RecalculatePrimRef<Mesh>(scene),
@@ -213,6 +230,7 @@ namespace embree
                                             CreateMSMBlurLeaf<N,Mesh,Primitive>(bvh),
                                             bvh->scene->progressInterface,
                                             settings);
+        hierarchyTimer.stop();
 
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
       }
@@ -588,8 +606,10 @@ namespace embree
         settings.travCost = travCost;
         settings.intCost = intCost;
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+        settings.stats = bvh->buildStats();
 
         /* build hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         auto root = BVHBuilderBinnedSAH::build<NodeRecordMB>
           (typename BVH::CreateAlloc(bvh),
            typename BVH::AlignedNodeMB::Create2(),
@@ -597,6 +617,7 @@ namespace embree
            CreateLeafGridMB<N>(scene,bvh,sgrids.data()),
            bvh->scene->progressInterface,
            prims.data(),pinfo,settings);
+        hierarchyTimer.stop();
 
         bvh->set(root.ref,root.lbounds,pinfo.size());
       }
@@ -635,6 +656,7 @@ namespace embree
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
         
         /* build hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         auto root =
           BVHBuilderMSMBlur::build<NodeRef>(prims,pinfo,scene->device,
                                             recalculatePrimRef,
@@ -644,6 +666,7 @@ namespace embree
                                             CreateMSMBlurLeafGrid<N>(scene,bvh,sgrids.data()),
                                             bvh->scene->progressInterface,
                                             settings);
+        hierarchyTimer.stop();
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
       }
 
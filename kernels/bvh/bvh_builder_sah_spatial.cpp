@@ -61,6 +61,34 @@ namespace embree
       BVH* bvh;
     };
 
+    template<int N>
+    struct SetSpatial
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      __forceinline SetSpatial (FastAllocator* allocator, PrimRef* prims) : allocator(allocator), prims(prims) {}
+
+      template<typename BuildRecord>
+      __forceinline NodeRef operator() (const BuildRecord& precord, const BuildRecord* crecords, NodeRef ref, NodeRef* children, const size_t num) const
+      {
+        typename BVH::AlignedNode* node = ref.alignedNode();
+        for (size_t i=0; i<num; i++) node->setRef(i,children[i]);
+
+        /* the primrefs of a finished subtree including its space for spatial splits can hold further nodes and leaves */
+        if (unlikely(precord.alloc_barrier))
+        {
+          PrimRef* begin = &prims[precord.prims.begin()];
+          PrimRef* end   = &prims[precord.prims.ext_end()];
+          allocator->addBlock(begin,(size_t)end - (size_t)begin);
+        }
+        return ref;
+      }
+
+      FastAllocator* const allocator;
+      PrimRef* const prims;
+    };
+
     template<int N, typename Mesh, typename Primitive, typename Splitter>
     struct BVHNBuilderFastSpatialSAH : public Builder
     {
@@ -72,17 +100,51 @@ namespace embree
       mvector<PrimRef> prims0;
       GeneralBVHBuilder::Settings settings;
       const float splitFactor;
+      const size_t minLeafSize;
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(scene->device->max_spatial_split_replications), minLeafSize(minLeafSize) {}
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(scene->device->max_spatial_split_replications), minLeafSize(minLeafSize) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
+      /* size of the primref array including the space reserved for spatial splits */
+      __forceinline size_t numSplitPrimitives(size_t numOriginalPrimitives) const
+      {
+        if (bvh->scene->memoryBudgetLevel >= Scene::MEMORY_BUDGET_NO_SPATIAL_SPLITS)
+          return numOriginalPrimitives;
+        return max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+      }
+
+      /* estimated size of the BVH in the build mode selected by the memory budget */
+      __forceinline size_t bvhBytes(size_t numPrimitives) const
+      {
+        const size_t node_bytes = numPrimitives*sizeof(typename BVH::AlignedNode)/(4*N*bvh->scene->leafSizeScale());
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        return node_bytes+leaf_bytes;
+      }
+
+      /* subtree size below which the BVH gets allocated inside the primref array */
+      __forceinline size_t primrefArrayAllocThreshold(size_t numPrimitives) const
+      {
+        if (scene && scene->isLowMemoryBuild())
+          return max(numPrimitives/1000,size_t(1000));
+        return inf;
+      }
+
+      size_t estimateMemory()
+      {
+        const size_t numOriginalPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
+        const size_t prim_bytes = numSplitPrimitives(numOriginalPrimitives)*sizeof(PrimRef);
+        if (primrefArrayAllocThreshold(numOriginalPrimitives) < numOriginalPrimitives)
+          return max(prim_bytes,bvhBytes(numOriginalPrimitives));
+        return prim_bytes+bvhBytes(numOriginalPrimitives);
+      }
+
       void build()
       {
         /* we reset the allocator when the mesh size changed */
@@ -90,6 +152,10 @@ namespace embree
           bvh->alloc.clear();
         }
 
+        /* if we use the primrefarray for allocations we have to take it back from the BVH */
+        if (settings.primrefarrayalloc != size_t(inf))
+          bvh->alloc.unshare(prims0);
+
 	/* skip build for empty scene */
         const size_t numOriginalPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
         if (numOriginalPrimitives == 0) {
@@ -101,7 +167,7 @@ namespace embree
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderFastSpatialSAH");
 
         /* create primref array */
-        const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+        const size_t numSplitPrimitives = this->numSplitPrimitives(numOriginalPrimitives);
         prims0.resize(numSplitPrimitives);
         PrimInfo pinfo = mesh ?
           createPrimRefArray(mesh,prims0,bvh->scene->progressInterface) :
@@ -113,30 +179,39 @@ namespace embree
         if (mesh)
           bvh->alloc.setOSallocation(true);
 
-        const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AlignedNode)/(4*N);
-        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
-        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
-        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+        const size_t bytesEstimated = bvhBytes(pinfo.size());
+        bvh->alloc.init_estimate(bytesEstimated);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),bytesEstimated);
+        settings.minLeafSize = min(minLeafSize*bvh->scene->leafSizeScale(),settings.maxLeafSize);
+        settings.primrefarrayalloc = primrefArrayAllocThreshold(numOriginalPrimitives);
 
         settings.branchingFactor = N;
         settings.maxDepth = BVH::maxBuildDepthLeaf;
+        settings.stats = bvh->buildStats();
+        settings.splitTask = BuildStatistics::SPATIAL_SPLITS;
 
+        BuildStatistics::PhaseTimer hierarchyTimer(settings.stats,BuildStatistics::HIERARCHY);
         NodeRef root = BVHBuilderBinnedFastSpatialSAH::build<NodeRef>(
           typename BVH::CreateAlloc(bvh),
           typename BVH::AlignedNode::Create2(),
-          typename BVH::AlignedNode::Set2(),
+          SetSpatial<N>(&bvh->alloc,prims0.data()),
           CreateLeafSpatial<N,Primitive>(bvh),
           splitter,
           bvh->scene->progressInterface,
           prims0.data(),
           numSplitPrimitives,
           pinfo,settings);
+        hierarchyTimer.stop();
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
 
+        /* if we allocated using the primrefarray we have to keep it alive */
+        if (settings.primrefarrayalloc != size_t(inf))
+          bvh->alloc.share(prims0);
+
 	/* clear temporary data for static geometry */
-	if (scene && scene->isStaticAccel()) {
+	else if (scene && scene->isStaticAccel()) {
           prims0.clear();
           bvh->shrink();
         }
@@ -176,8 +176,11 @@ namespace embree
         settings.travCost = 1.0f;
         settings.intCost = 1.0f;
         settings.singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD;
+        settings.stats = bvh->buildStats();
 
+        BuildStatistics::PhaseTimer hierarchyTimer(settings.stats,BuildStatistics::HIERARCHY);
         NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,createLeaf,virtualprogress,prims.data(),pinfo,settings);
+        hierarchyTimer.stop();
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
         
@@ -336,6 +339,7 @@ namespace embree
         settings.singleLeafTimeSegment = false;
 
         /* build hierarchy */
+        BuildStatistics::PhaseTimer hierarchyTimer(bvh->buildStats(),BuildStatistics::HIERARCHY);
         auto root =
           BVHBuilderMSMBlur::build<NodeRef>(primsMB,pinfo,scene->device,
                                              recalculatePrimRef,
@@ -345,6 +349,7 @@ namespace embree
                                              createLeafFunc,
                                              bvh->scene->progressInterface,
                                              settings);
+        hierarchyTimer.stop();
         
         bvh->set(root.ref,root.lbounds,pinfo.num_time_segments);
       }
@@ -30,13 +30,18 @@
 #define SPLIT_MEMORY_RESERVE_SCALE 2
 #define SPLIT_MIN_EXT_SPACE 1000
 
+/* incremental top-level updates */
+#define ENABLE_TOP_LEVEL_UPDATE 1
+#define TOP_LEVEL_UPDATE_THRESHOLD 8 // update incrementally as long as at most 1/8 of the objects got modified since the last top-level build
+
 namespace embree
 {
   namespace isa
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel, const size_t singleThreadThreshold)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold),
+        leafRefs(scene->device,0), topLevelValid(false), numUpdatedObjects(0) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel () {
@@ -52,6 +57,7 @@ namespace embree
       /* delete some objects */
       size_t num = scene->size();
       if (num < objects.size()) {
+        topLevelValid = false;
         parallel_for(num, objects.size(), [&] (const range<size_t>& r) {
             for (size_t i=r.begin(); i<r.end(); i++) {
               builders[i].clear();
@@ -64,15 +70,14 @@ namespace embree
       while(1) 
 #endif
       {
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives<Mesh,false>();
 
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
+        topLevelValid = false;
         return;
       }
 
@@ -82,7 +87,10 @@ namespace embree
       if (objects.size()  < num) objects.resize(num);
       if (builders.size() < num) builders.resize(num);
       if (refs.size()     < num) refs.resize(num);
+      if (modifiedObjects.size() < num) modifiedObjects.resize(num);
       nextRef.store(0);
+      std::atomic<size_t> nextModified(0);
+      std::atomic<bool> topLevelChanged(false);
       
       /* create acceleration structures */
       parallel_for(size_t(0), num, [&] (const range<size_t>& r)
@@ -108,6 +116,7 @@ namespace embree
             delete objects[objectID]; 
             createMeshAccel(mesh,(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            topLevelChanged = true;
           }
         }
       });
@@ -119,18 +128,28 @@ namespace embree
         {
           /* ignore if no triangle mesh or not enabled */
           Mesh* mesh = scene->getSafe<Mesh>(objectID);
-          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) 
+          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) {
+            if (builders[objectID].inTopLevel) topLevelChanged = true;
+            builders[objectID].inTopLevel = false;
             continue;
+          }
         
           BVH*     object  = objects [objectID]; assert(object);
           Ref<Builder>& builder = builders[objectID].builder; assert(builder);
           
           /* build object if it got modified */
-          if (mesh->isModified())
+          const bool modified = mesh->isModified();
+          if (modified)
             builder->build();
 
+          /* objects that enter or leave the top-level BVH require a top-level build */
+          const bool inTopLevel = !object->getBounds().empty();
+          if (inTopLevel != builders[objectID].inTopLevel) topLevelChanged = true;
+          builders[objectID].inTopLevel = inTopLevel;
+          if (inTopLevel && modified) modifiedObjects[nextModified++] = (unsigned int)objectID;
+
           /* create build primitive */
-          if (!object->getBounds().empty())
+          if (inTopLevel)
           {
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root,(unsigned int)objectID,(unsigned int)mesh->size());
@@ -145,13 +164,29 @@ namespace embree
 #if PROFILE
       double d0 = getSeconds();
 #endif
+      BuildStatistics::PhaseTimer topLevelTimer(bvh->buildStats(),BuildStatistics::TOPLEVEL);
+
+      /* incrementally update the top-level BVH if only a few objects got modified */
+      const size_t numModified = nextModified;
+      if (ENABLE_TOP_LEVEL_UPDATE && topLevelValid && !topLevelChanged && nextRef > 1 &&
+          TOP_LEVEL_UPDATE_THRESHOLD*(numUpdatedObjects+numModified) <= size_t(nextRef))
+      {
+        updateTopLevel(numModified,numPrimitives);
+      }
+
       /* fast path for single geometry scenes */
-      if (nextRef == 1) { 
+      else if (nextRef == 1) { 
+        bvh->alloc.reset();
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
+        topLevelValid = false;
       }
 
       else
       {     
+        /* reset memory allocator */
+        bvh->alloc.reset();
+        topLevelValid = false;
+
         /* open all large nodes */
         refs.resize(nextRef);
 
@@ -221,6 +256,8 @@ namespace embree
       
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             refs.resize(extSize); 
+            leafRefs.resize(extSize);
+            nextLeafRef.store(0);
          
             NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
@@ -229,6 +266,7 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
+                leafRefs[nextLeafRef++] = refs[range.begin()];
                 return (NodeRef) refs[range.begin()].node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
@@ -236,6 +274,8 @@ namespace embree
               },              
               [&] (size_t dn) { bvh->scene->progressMonitor(0); },
               refs.data(),extSize,pinfo,settings);
+
+            linkTopLevel(root,nextLeafRef);
 #else
             NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
               typename BVH::CreateAlloc(bvh),
@@ -261,6 +301,7 @@ namespace embree
       }  
         
       bvh->alloc.cleanup();
+      topLevelTimer.stop();
       bvh->postBuild(t0);
 #if PROFILE
       double d1 = getSeconds();
@@ -274,10 +315,26 @@ namespace embree
     void BVHNBuilderTwoLevel<N,Mesh>::deleteGeometry(size_t geomID)
     {
       if (geomID >= objects.size()) return;
+      topLevelValid = false;
       builders[geomID].clear();
       delete objects [geomID]; objects [geomID] = nullptr;
     }
 
+    template<int N, typename Mesh>
+    size_t BVHNBuilderTwoLevel<N,Mesh>::estimateMemory()
+    {
+      /* object BVHs, sized like the top-level BVH estimate */
+      const size_t numPrimitives = scene->getNumPrimitives<Mesh,false>();
+      const size_t node_bytes = numPrimitives*sizeof(typename BVH::AlignedNodeMB)/(4*N);
+      const size_t leaf_bytes = size_t(1.2*44*numPrimitives); // assumes triangles
+
+      /* build data of the object builders and of the top-level build */
+      const size_t prim_bytes = numPrimitives*sizeof(PrimRef);
+      const size_t extSize = max(max((size_t)SPLIT_MIN_EXT_SPACE,scene->size()*SPLIT_MEMORY_RESERVE_SCALE),size_t((float)numPrimitives / SPLIT_MEMORY_RESERVE_FACTOR));
+      const size_t ref_bytes = 2*extSize*sizeof(BuildRef);
+      return node_bytes+leaf_bytes+prim_bytes+ref_bytes;
+    }
+
     template<int N, typename Mesh>
     void BVHNBuilderTwoLevel<N,Mesh>::clear()
     {
@@ -288,6 +345,9 @@ namespace embree
 	if (builders[i].builder) builders[i].builder->clear();
 
       refs.clear();
+      leafRefs.clear();
+      topLevelNodes.clear();
+      topLevelValid = false;
     }
 
     template<int N, typename Mesh>
@@ -330,6 +390,88 @@ namespace embree
       }
     }
 
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::linkTopLevel(NodeRef root, size_t numLeaves)
+    {
+      topLevelValid = false;
+      topLevelNodes.clear();
+      for (size_t i=0; i<builders.size(); i++)
+        builders[i].topLevelSlots.clear();
+
+      /* sort leaves by node reference for fast lookup */
+      auto compare = [] (const BuildRef& a, const BuildRef& b) { return size_t(a.node) < size_t(b.node); };
+      std::sort(leafRefs.begin(),leafRefs.begin()+numLeaves,compare);
+      auto findLeaf = [&] (NodeRef ref) -> const BuildRef* {
+        BuildRef key; key.node = ref;
+        const BuildRef* leaf = std::lower_bound(leafRefs.begin(),leafRefs.begin()+numLeaves,key,compare);
+        if (leaf == leafRefs.begin()+numLeaves || leaf->node != ref) return nullptr;
+        return leaf;
+      };
+
+      /* the root has to be a top-level node */
+      if (!root.isAlignedNode() || findLeaf(root))
+        return;
+
+      /* record all top-level nodes and the child slots that reference objects */
+      std::vector<TopLevelNode> stack;
+      stack.push_back(TopLevelNode(root.alignedNode(),size_t(-1)));
+      while (!stack.empty())
+      {
+        const TopLevelNode cur = stack.back(); stack.pop_back();
+        const size_t nodeID = topLevelNodes.size();
+        topLevelNodes.push_back(cur);
+
+        for (size_t i=0; i<N; i++)
+        {
+          NodeRef child = cur.node->child(i);
+          if (child == BVH::emptyNode) continue;
+          if (const BuildRef* leaf = findLeaf(child))
+            builders[leaf->geomID()].topLevelSlots.push_back(nodeID*N+i);
+          else if (child.isAlignedNode())
+            stack.push_back(TopLevelNode(child.alignedNode(),nodeID*N+i));
+          else
+            return;
+        }
+      }
+      topLevelValid = true;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::updateTopLevel(size_t numModified, size_t numPrimitives)
+    {
+      for (size_t m=0; m<numModified; m++)
+      {
+        const unsigned int objectID = modifiedObjects[m];
+        BVH* object = objects[objectID];
+        std::vector<size_t>& slots = builders[objectID].topLevelSlots;
+        assert(slots.size());
+
+        /* the first slot references the rebuilt object, all other slots got opened from the old object and become empty leaves */
+        for (size_t j=0; j<slots.size(); j++)
+        {
+          size_t slot = slots[j];
+          AlignedNode* node = topLevelNodes[slot/N].node;
+          if (j == 0) node->set(slot%N,object->root,object->getBounds());
+          else        node->set(slot%N,BVH::encodeLeaf(node,0),empty);
+
+          /* refit all parents until bounds do not change anymore */
+          for (size_t parentSlot = topLevelNodes[slot/N].parentSlot; parentSlot != size_t(-1); parentSlot = topLevelNodes[slot/N].parentSlot)
+          {
+            const BBox3fa bounds = node->bounds();
+            AlignedNode* parent = topLevelNodes[parentSlot/N].node;
+            const BBox3fa oldBounds = parent->bounds(parentSlot%N);
+            if (all(eq_mask(bounds.lower,oldBounds.lower)) && all(eq_mask(bounds.upper,oldBounds.upper))) break;
+            parent->setBounds(parentSlot%N,bounds);
+            node = parent; slot = parentSlot;
+          }
+        }
+        slots.resize(1);
+      }
+      numUpdatedObjects += numModified;
+
+      bvh->set(bvh->root,LBBox3fa(topLevelNodes[0].node->bounds()),numPrimitives);
+    }
+
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     Builder* BVH4BuilderTwoLevelTriangleMeshSAH (void* bvh, Scene* scene, const createTriangleMeshAccelTy createMeshAccel) {
       return new BVHNBuilderTwoLevel<4,TriangleMesh>((BVH4*)bvh,scene,createMeshAccel);
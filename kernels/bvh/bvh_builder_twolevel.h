@@ -110,26 +110,48 @@ namespace embree
       void build();
       void deleteGeometry(size_t geomID);
       void clear();
+      size_t estimateMemory();
 
       void open_sequential(const size_t extSize);
 
+      /*! links the leaves of a newly built top-level BVH to their objects */
+      void linkTopLevel(NodeRef root, size_t numLeaves);
+
+      /*! replaces the top-level leaves of modified objects and refits the top-level BVH above them */
+      void updateTopLevel(size_t numModified, size_t numPrimitives);
+
     public:
       
       struct BuilderState
       {
         BuilderState ()
-        : builder(nullptr), quality(RTC_BUILD_QUALITY_LOW) {}
+        : builder(nullptr), quality(RTC_BUILD_QUALITY_LOW), inTopLevel(false) {}
 
         BuilderState (const Ref<Builder>& builder, RTCBuildQuality quality)
-        : builder(builder), quality(quality) {}
+        : builder(builder), quality(quality), inTopLevel(false) {}
         
         void clear() {
           builder = nullptr;
           quality = RTC_BUILD_QUALITY_LOW;
+          inTopLevel = false;
+          topLevelSlots.clear();
         }
         
         Ref<Builder> builder;
         RTCBuildQuality quality;
+        bool inTopLevel;                   //!< true if the object got referenced by the last top-level build
+        std::vector<size_t> topLevelSlots; //!< top-level child slots (nodeID*N+i) referencing the object
+      };
+
+      /*! top-level node with link to the child slot of its parent */
+      struct TopLevelNode
+      {
+        __forceinline TopLevelNode () {}
+        __forceinline TopLevelNode (AlignedNode* node, size_t parentSlot)
+          : node(node), parentSlot(parentSlot) {}
+
+        AlignedNode* node;
+        size_t parentSlot; //!< parent slot (nodeID*N+i), or -1 for the root node
       };
       
     public:
@@ -146,6 +168,14 @@ namespace embree
       std::atomic<int> nextRef;
       const size_t singleThreadThreshold;
 
+      /* state for incremental updates of the top-level BVH */
+      mvector<BuildRef> leafRefs;              //!< leaves of the last top-level build
+      std::atomic<size_t> nextLeafRef;
+      std::vector<unsigned int> modifiedObjects;
+      std::vector<TopLevelNode> topLevelNodes; //!< nodes of the last top-level build
+      bool topLevelValid;                      //!< true if the top-level BVH can get updated incrementally
+      size_t numUpdatedObjects;                //!< number of objects updated incrementally since the last top-level build
+
       typedef mvector<BuildRef> bvector;
 
     };
@@ -200,5 +200,90 @@ namespace embree
         }
       }
     }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    bool BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::pointQuery(const Accel::Intersectors* __restrict__ This,
+                                                                               RTCPointQuery* __restrict__ query,
+                                                                               PointQueryContext* __restrict__ context)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+      const PrimitiveType* primTy = bvh->primTy;
+      Scene* scene = context->scene;
+      bool changed = false;
+
+      /* stack state */
+      StackItemT<NodeRef> stack[stackSize];    // stack of nodes
+      StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
+      stack[0].ptr  = bvh->root;
+      stack[0].dist = 0;
+
+      /* load the query point into SIMD registers, distances are compared squared */
+      const Vec3vf<N> p(query->x,query->y,query->z);
+      float radius2 = sqr(query->radius);
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /* pop next node */
+        if (unlikely(stackPtr == stack)) break;
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+
+        /* if popped node is outside the query radius, pop next one */
+        if (unlikely(*(float*)&stackPtr->dist > radius2))
+          continue;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          size_t mask; vfloat<N> dist;
+          bool nodeIntersected = BVHNNodePointQuery1<N, types>::pointQuery(cur, p, query->time, radius2, dist, mask);
+          if (unlikely(!nodeIntersected)) break;
+
+          /* if no child is inside the query radius, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* push all children sorted by distance and continue with the closest one */
+          const typename BVH::BaseNode* node = cur.baseNode(types);
+          StackItemT<NodeRef>* stackBegin = stackPtr;
+          do {
+            const size_t i = bscf(mask);
+            stackPtr->ptr = node->child(i);
+            *(float*)&stackPtr->dist = dist[i];
+            stackPtr++;
+          } while (mask);
+          sort(stackBegin,stackPtr);
+          stackPtr--;
+          cur = NodeRef(stackPtr->ptr);
+        }
+
+        /* this is a leaf node, report all primitives of the leaf */
+        size_t num; const char* prim = cur.leaf(num);
+        for (size_t i=0; i<num; i++)
+        {
+          const size_t items = primTy->sizeActive(prim);
+          for (size_t j=0; j<items; j++)
+          {
+            const unsigned int geomID = primTy->getGeomID(prim,j);
+            const Geometry* geom = scene->get(geomID);
+            RTCPointQueryFunction func = geom->pointQueryFunc ? geom->pointQueryFunc : context->func;
+            if (func == nullptr) continue;
+
+            RTCPointQueryFunctionArguments args;
+            args.query = query;
+            args.userPtr = context->userPtr;
+            args.primID = primTy->getPrimID(prim,j);
+            args.geomID = geomID;
+            if (func(&args)) {
+              radius2 = sqr(query->radius);
+              changed = true;
+            }
+          }
+          prim += primTy->getBytes(prim);
+        }
+      }
+      return changed;
+    }
   }
 }
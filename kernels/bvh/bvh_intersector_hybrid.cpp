@@ -878,7 +878,7 @@ namespace embree
               const size_t i = bscf(m_frustum_node);
               vfloat<K> lnearP;
               vbool<K> lhit = false; // motion blur is not supported, so the initial value will be ignored
-              STAT3(normal.trav_nodes, 1, 1, 1);
+              STAT3(shadow.trav_nodes, 1, 1, 1);
               BVHNNodeIntersectorK<N, K, types, robust>::intersect(nodeRef, i, tray, ray.time(), lnearP, lhit);
 
               if (likely(any(lhit)))
@@ -903,9 +903,7 @@ namespace embree
           /* intersect leaf */
           assert(cur != BVH::invalidNode);
           assert(cur != BVH::emptyNode);
-#if defined(__AVX__)
-          STAT3(normal.trav_leaves, 1, popcnt(m_active), K);
-#endif
+          STAT3(shadow.trav_leaves, 1, popcnt(m_active), K);
           if (unlikely(!m_active)) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
 
@@ -48,9 +48,10 @@ namespace embree
                                                                                                     size_t numOctantRays,
                                                                                                     IntersectContext* context)
     {
-      // Only the coherent code path is implemented
-      assert(context->isCoherent());
-      intersectCoherent(This, (RayHitK<VSIZEL>**)inputPackets, numOctantRays, context);
+      if (unlikely(context->isCoherent()))
+        intersectCoherent(This, (RayHitK<VSIZEL>**)inputPackets, numOctantRays, context);
+      else
+        intersectIncoherent(This, (RayHitK<VSIZEX>**)inputPackets, numOctantRays, context);
     }
 
     template<int N, int Nx, int types, bool robust, typename PrimitiveIntersector>
@@ -161,6 +162,145 @@ namespace embree
       } // traversal + intersection
     }
 
+    template<int N, int Nx, int types, bool robust, typename PrimitiveIntersector>
+    template<int K>
+    __forceinline void BVHNIntersectorStream<N, Nx, types, robust, PrimitiveIntersector>::intersectIncoherent(Accel::Intersectors* __restrict__ This,
+                                                                                                              RayHitK<K>** inputPackets,
+                                                                                                              size_t numOctantRays,
+                                                                                                              IntersectContext* context)
+    {
+      assert(!context->isCoherent());
+      assert(types & BVH_FLAG_ALIGNED_NODE);
+
+      __aligned(64) TravRayKStream<K,robust> packet[MAX_INTERNAL_STREAM_SIZE/K];
+
+      assert(numOctantRays <= 32);
+      const size_t numPackets = (numOctantRays+K-1)/K;
+      size_t m_active = 0;
+      for (size_t i = 0; i < numPackets; i++)
+      {
+        const vfloat<K> tnear = inputPackets[i]->tnear();
+        const vfloat<K> tfar  = inputPackets[i]->tfar;
+        vbool<K> m_valid = (tnear <= tfar) & (tnear >= 0.0f);
+        m_active |= (size_t)movemask(m_valid) << (K*i);
+        const Vec3vf<K>& org = inputPackets[i]->org;
+        const Vec3vf<K>& dir = inputPackets[i]->dir;
+        vfloat<K> packet_min_dist = max(tnear, 0.0f);
+        vfloat<K> packet_max_dist = select(m_valid, tfar, neg_inf);
+        new (&packet[i]) TravRayKStream<K,robust>(org, dir, packet_min_dist, packet_max_dist);
+      }
+      m_active &= (numOctantRays == (8 * sizeof(size_t))) ? (size_t)-1 : (((size_t)1 << numOctantRays)-1);
+      if (unlikely(m_active == 0)) return;
+
+      BVH* __restrict__ bvh = (BVH*)This->ptr;
+
+      StackItemMaskT<NodeRef> stack[stackSizeSingle]; // stack of nodes
+      StackItemMaskT<NodeRef>* stackPtr = stack + 1;  // current stack pointer
+      stack[0].ptr = bvh->root;
+      stack[0].mask = m_active;
+
+      /* near/far offsets based on first ray */
+      const NearFarPrecalculations nf(Vec3fa(packet[0].rdir.x[0], packet[0].rdir.y[0], packet[0].rdir.z[0]), N);
+
+      while (1) pop:
+      {
+        if (unlikely(stackPtr == stack)) break;
+        STAT3(normal.trav_stack_pop,1,1,1);
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+        size_t cur_mask = stackPtr->mask;
+        assert(cur_mask);
+
+        while (true)
+        {
+          /*! stop if we found a leaf node */
+          if (unlikely(cur.isLeaf())) break;
+          const AlignedNode* __restrict__ const node = cur.alignedNode();
+
+          vfloat<Nx> dist;
+          const vint<Nx> vmask = traverseIncoherentStream<true>(cur_mask, packet, node, nf, shiftTable, dist);
+
+          size_t mask = movemask(vmask != vint<Nx>(zero));
+          if (unlikely(mask == 0)) goto pop;
+
+          __aligned(64) unsigned int child_mask[Nx];
+          vint<Nx>::storeu(child_mask, vmask); // this explicit store here causes much better code generation
+
+          /*! one child is hit, continue with that child */
+          size_t r = bscf(mask);
+          assert(r < N);
+          if (likely(mask == 0))
+          {
+            cur = node->child(r);
+            cur.prefetch(types);
+            cur_mask = child_mask[r];
+            assert(cur != BVH::emptyNode);
+            continue;
+          }
+
+          /*! two or more children are hit, order them far to near by the closest entry distance of their rays */
+          __aligned(64) float child_dist[Nx];
+          vfloat<Nx>::storeu(child_dist, dist);
+          size_t order[N];
+          size_t numHits = 1;
+          order[0] = r;
+          do
+          {
+            const size_t c = bscf(mask);
+            assert(c < N);
+            size_t j = numHits++;
+            for (; j > 0 && child_dist[order[j-1]] < child_dist[c]; j--)
+              order[j] = order[j-1];
+            order[j] = c;
+          } while (mask);
+
+          /*! push all but the nearest child and continue with the nearest one */
+          for (size_t i = 0; i < numHits-1; i++)
+          {
+            NodeRef child = node->child(order[i]);
+            child.prefetch(types);
+            assert(child != BVH::emptyNode);
+            stackPtr->ptr  = child;
+            stackPtr->mask = child_mask[order[i]];
+            stackPtr++;
+          }
+          r = order[numHits-1];
+          cur = node->child(r);
+          cur.prefetch(types);
+          cur_mask = child_mask[r];
+          assert(cur != BVH::emptyNode);
+        }
+
+        /*! this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        STAT3(normal.trav_leaves,1,1,1);
+        size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
+
+        size_t bits = cur_mask;
+        size_t lazy_node = 0;
+
+        for (; bits != 0;)
+        {
+          const size_t rayID = bscf(bits);
+
+          RayHitK<K> &ray = *inputPackets[rayID / K];
+          const size_t k = rayID % K;
+          PrimitiveIntersectorK<K>::intersect(This, ray, k, context, prim, num, lazy_node);
+
+          /* shrink the traversal interval of that ray to cull farther nodes */
+          packet[rayID / K].tfar[k] = ray.tfar[k];
+        }
+
+        /* lazy node */
+        if (unlikely(lazy_node))
+        {
+          stackPtr->ptr = lazy_node;
+          stackPtr->mask = cur_mask;
+          stackPtr++;
+        }
+      }
+    }
+
     template<int N, int Nx, int types, bool robust, typename PrimitiveIntersector>
     __forceinline void BVHNIntersectorStream<N, Nx, types, robust, PrimitiveIntersector>::occluded(Accel::Intersectors* __restrict__ This,
                                                                                                    RayN** inputPackets,
@@ -341,7 +481,8 @@ namespace embree
           if (unlikely(cur.isLeaf())) break;
           const AlignedNode* __restrict__ const node = cur.alignedNode();
 
-          const vint<Nx> vmask = traverseIncoherentStream(cur_mask, packet, node, nf, shiftTable);
+          vfloat<Nx> dist;
+          const vint<Nx> vmask = traverseIncoherentStream<false>(cur_mask, packet, node, nf, shiftTable, dist);
 
           size_t mask = movemask(vmask != vint<Nx>(zero));
           if (unlikely(mask == 0)) goto pop;
@@ -162,12 +162,13 @@ namespace embree
       }
       
       // TODO: explicit 16-wide path for KNL
-      template<int K>
+      template<bool closest, int K>
       __forceinline static vint<Nx> traverseIncoherentStream(size_t m_active,
                                                              TravRayKStreamFast<K>* __restrict__ packets,
                                                              const AlignedNode* __restrict__ node,
                                                              const NearFarPrecalculations& nf,
-                                                             const int shiftTable[32])
+                                                             const int shiftTable[32],
+                                                             vfloat<Nx>& dist)
       {
         const vfloat<Nx> bminX = vfloat<Nx>(*(const vfloat<N>*)((const char*)&node->lower_x + nf.nearX));
         const vfloat<Nx> bminY = vfloat<Nx>(*(const vfloat<N>*)((const char*)&node->lower_x + nf.nearY));
@@ -177,9 +178,11 @@ namespace embree
         const vfloat<Nx> bmaxZ = vfloat<Nx>(*(const vfloat<N>*)((const char*)&node->lower_x + nf.farZ));
         assert(m_active);
         vint<Nx> vmask(zero);
+        if (closest) dist = vfloat<Nx>(pos_inf);
         do
         {   
-          STAT3(shadow.trav_nodes,1,1,1);
+          if (closest) { STAT3(normal.trav_nodes,1,1,1); }
+          else         { STAT3(shadow.trav_nodes,1,1,1); }
           const size_t rayID = bscf(m_active);
           assert(rayID < MAX_INTERNAL_STREAM_SIZE);
           TravRayKStream<K,robust> &p = packets[rayID / K];
@@ -206,16 +209,18 @@ namespace embree
           vmask = select(hit_mask, vmask | bitmask, vmask);
 #endif
 #endif
+          if (closest) dist = select(hit_mask, min(dist, tNear), dist);
         } while(m_active);
         return vmask;        
       }
 
-      template<int K>
+      template<bool closest, int K>
       __forceinline static vint<Nx> traverseIncoherentStream(size_t m_active,
                                                              TravRayKStreamRobust<K>* __restrict__ packets,
                                                              const AlignedNode* __restrict__ node,
                                                              const NearFarPrecalculations& nf,
-                                                             const int shiftTable[32])
+                                                             const int shiftTable[32],
+                                                             vfloat<Nx>& dist)
       {
         const vfloat<Nx> bminX = vfloat<Nx>(*(const vfloat<N>*)((const char*)&node->lower_x + nf.nearX));
         const vfloat<Nx> bminY = vfloat<Nx>(*(const vfloat<N>*)((const char*)&node->lower_x + nf.nearY));
@@ -225,9 +230,11 @@ namespace embree
         const vfloat<Nx> bmaxZ = vfloat<Nx>(*(const vfloat<N>*)((const char*)&node->lower_x + nf.farZ));
         assert(m_active);
         vint<Nx> vmask(zero);
+        if (closest) dist = vfloat<Nx>(pos_inf);
         do
         {   
-          STAT3(shadow.trav_nodes,1,1,1);
+          if (closest) { STAT3(normal.trav_nodes,1,1,1); }
+          else         { STAT3(shadow.trav_nodes,1,1,1); }
           const size_t rayID = bscf(m_active);
           assert(rayID < MAX_INTERNAL_STREAM_SIZE);
           TravRayKStream<K,robust> &p = packets[rayID / K];
@@ -255,6 +262,7 @@ namespace embree
           vmask = select(hit_mask, vmask | bitmask, vmask);
 #endif
 #endif
+          if (closest) dist = select(hit_mask, min(dist, tNear), dist);
         } while(m_active);
         return vmask;
       }
@@ -270,6 +278,9 @@ namespace embree
       template<int K>
       static void intersectCoherent(Accel::Intersectors* This, RayHitK<K>** inputRays, size_t numRays, IntersectContext* context);
 
+      template<int K>
+      static void intersectIncoherent(Accel::Intersectors* This, RayHitK<K>** inputRays, size_t numRays, IntersectContext* context);
+
       template<int K>
       static void occludedCoherent(Accel::Intersectors* This, RayK<K>** inputRays, size_t numRays, IntersectContext* context);
 
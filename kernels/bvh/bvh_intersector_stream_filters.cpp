@@ -21,6 +21,39 @@ namespace embree
 {
   namespace isa
   {
+    template<typename GetRay>
+    __forceinline void RayStreamFilter::sortRays(Scene* scene, size_t begin, size_t end, unsigned int* order, const GetRay& getRay)
+    {
+      const size_t numRays = end-begin;
+      assert(numRays <= RAY_SORT_WINDOW);
+      __aligned(64) uint64_t keys[RAY_SORT_WINDOW];
+
+      /* origins get quantized to a 1024^3 grid over the scene bounds */
+      const BBox3fa bounds = scene->getBounds();
+      const Vec3fa base  = bounds.lower;
+      const Vec3fa scale = Vec3fa(1023.99f) / max(bounds.size(), Vec3fa(1E-19f));
+
+      for (size_t i = 0; i < numRays; i++)
+      {
+        const Ray ray = getRay(begin+i);
+        const Vec3fa org(ray.org);
+        const Vec3fa dir(ray.dir);
+
+        const unsigned int octantID = movemask(vfloat4(dir) < 0.0f) & 0x7;
+        const Vec3fa o = min(max((org-base)*scale, Vec3fa(0.0f)), Vec3fa(1023.0f));
+        const Vec3fa d = min(max(abs(dir)*(15.99f*rsqrt(dot(dir,dir))), Vec3fa(0.0f)), Vec3fa(15.0f));
+        const uint64_t orgCode = bitInterleave((unsigned int)o.x, (unsigned int)o.y, (unsigned int)o.z);
+        const uint64_t dirCode = bitInterleave((unsigned int)d.x, (unsigned int)d.y, (unsigned int)d.z);
+
+        /* rays of an octant stay together, inside an octant rays get ordered by origin first */
+        keys[i] = ((uint64_t)octantID << 52) | (orgCode << 22) | (dirCode << 10) | i;
+      }
+
+      std::sort(keys, keys+numRays);
+      for (size_t i = 0; i < numRays; i++)
+        order[i] = (unsigned int)(begin + (keys[i] & (RAY_SORT_WINDOW-1)));
+    }
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
@@ -53,7 +86,7 @@ namespace embree
           }
 
           /* trace stream */
-          scene->intersectors.intersectN(rayPtrs, size, context);
+          scene->localIntersectors().intersectN(rayPtrs, size, context);
 
           /* convert from SOA to AOS */
           for (size_t j = 0; j < size; j += K)
@@ -66,12 +99,16 @@ namespace embree
           }
         }
       }
-      else if (unlikely(!intersect))
+      else
       {
-        /* octant sorting for occlusion rays */
+        /* octant sorting for incoherent rays */
         __aligned(64) unsigned int octants[8][MAX_INTERNAL_STREAM_SIZE];
-        __aligned(64) RayK<K> rays[MAX_INTERNAL_STREAM_SIZE / K];
-        __aligned(64) RayK<K>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+        __aligned(64) RayTypeK<K, intersect> rays[MAX_INTERNAL_STREAM_SIZE / K];
+        __aligned(64) RayTypeK<K, intersect>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+
+        /* optionally reorder large streams by origin and direction */
+        const bool reorder = context->isSortRays() && N > MAX_INTERNAL_STREAM_SIZE;
+        __aligned(64) unsigned int rayOrder[RAY_SORT_WINDOW];
 
         unsigned int raysInOctant[8];
         for (unsigned int i = 0; i < 8; i++)
@@ -85,7 +122,10 @@ namespace embree
           /* sort rays into octants */
           for (; inputRayID < N;)
           {
-            const Ray& ray = rayN.getRayByOffset(inputRayID * stride);
+            if (unlikely(reorder && inputRayID % RAY_SORT_WINDOW == 0))
+              sortRays(scene, inputRayID, min(N, inputRayID+RAY_SORT_WINDOW), rayOrder, [&] (size_t i) -> Ray { return rayN.getRayByOffset(i * stride); });
+            const size_t rayID = reorder ? rayOrder[inputRayID % RAY_SORT_WINDOW] : inputRayID;
+            const Ray& ray = rayN.getRayByOffset(rayID * stride);
 
             /* skip invalid rays */
             if (unlikely(ray.tnear() > ray.tfar || ray.tfar < 0.0f)) { inputRayID++; continue; } // ignore invalid or already occluded rays
@@ -96,7 +136,7 @@ namespace embree
             const unsigned int octantID = movemask(vfloat4(Vec3fa(ray.dir)) < 0.0f) & 0x7;
 
             assert(octantID < 8);
-            octants[octantID][raysInOctant[octantID]++] = (unsigned int)inputRayID;
+            octants[octantID][raysInOctant[octantID]++] = (unsigned int)rayID;
             inputRayID++;
             if (unlikely(raysInOctant[octantID] == MAX_INTERNAL_STREAM_SIZE))
             {
@@ -125,14 +165,14 @@ namespace embree
             const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
             const vbool<K> valid = vi < vint<K>(int(numOctantRays));
             const vint<K> offset = *(vint<K>*)&rayIDs[j] * int(stride);
-            RayK<K>& ray = rays[j/K];
+            RayTypeK<K, intersect>& ray = rays[j/K];
             rayPtrs[j/K] = &ray;
             ray = rayN.getRayByOffset(valid, offset);
             ray.tnear() = select(valid, ray.tnear(), zero);
             ray.tfar  = select(valid, ray.tfar,  neg_inf);
           }
 
-          scene->intersectors.occludedN(rayPtrs, numOctantRays, context);
+          scene->localIntersectors().intersectN(rayPtrs, numOctantRays, context);
 
           for (unsigned int j = 0; j < numOctantRays; j += K)
           {
@@ -145,23 +185,6 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
-      else
-      {
-        /* fallback to packets */
-        for (size_t i = 0; i < N; i += K)
-        {
-          const vint<K> vi = vint<K>(int(i)) + vint<K>(step);
-          vbool<K> valid = vi < vint<K>(int(N));
-          const vint<K> offset = vi * int(stride);
-
-          RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
-          valid &= ray.tnear() <= ray.tfar;
-
-          scene->intersectors.intersect(valid, ray, context);
-
-          rayN.setHitByOffset(valid, offset, ray);
-        }
-      }
     }
 
     template<int K, bool intersect>
@@ -195,7 +218,7 @@ namespace embree
           }
 
           /* trace stream */
-          scene->intersectors.intersectN(rayPtrs, size, context);
+          scene->localIntersectors().intersectN(rayPtrs, size, context);
 
           /* convert from SOA to AOP */
           for (size_t j = 0; j < size; j += K)
@@ -208,12 +231,16 @@ namespace embree
           }
         }
       }
-      else if (unlikely(!intersect))
+      else
       {
-        /* octant sorting for occlusion rays */
+        /* octant sorting for incoherent rays */
         __aligned(64) unsigned int octants[8][MAX_INTERNAL_STREAM_SIZE];
-        __aligned(64) RayK<K> rays[MAX_INTERNAL_STREAM_SIZE / K];
-        __aligned(64) RayK<K>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+        __aligned(64) RayTypeK<K, intersect> rays[MAX_INTERNAL_STREAM_SIZE / K];
+        __aligned(64) RayTypeK<K, intersect>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+
+        /* optionally reorder large streams by origin and direction */
+        const bool reorder = context->isSortRays() && N > MAX_INTERNAL_STREAM_SIZE;
+        __aligned(64) unsigned int rayOrder[RAY_SORT_WINDOW];
 
         unsigned int raysInOctant[8];
         for (unsigned int i = 0; i < 8; i++)
@@ -227,7 +254,10 @@ namespace embree
           /* sort rays into octants */
           for (; inputRayID < N;)
           {
-            const Ray& ray = rayN.getRayByIndex(inputRayID);
+            if (unlikely(reorder && inputRayID % RAY_SORT_WINDOW == 0))
+              sortRays(scene, inputRayID, min(N, inputRayID+RAY_SORT_WINDOW), rayOrder, [&] (size_t i) -> Ray { return rayN.getRayByIndex(i); });
+            const size_t rayID = reorder ? rayOrder[inputRayID % RAY_SORT_WINDOW] : inputRayID;
+            const Ray& ray = rayN.getRayByIndex(rayID);
 
             /* skip invalid rays */
             if (unlikely(ray.tnear() > ray.tfar || ray.tfar < 0.0f)) { inputRayID++; continue; } // ignore invalid or already occluded rays
@@ -238,7 +268,7 @@ namespace embree
             const unsigned int octantID = movemask(vfloat4(ray.dir) < 0.0f) & 0x7;
 
             assert(octantID < 8);
-            octants[octantID][raysInOctant[octantID]++] = (unsigned int)inputRayID;
+            octants[octantID][raysInOctant[octantID]++] = (unsigned int)rayID;
             inputRayID++;
             if (unlikely(raysInOctant[octantID] == MAX_INTERNAL_STREAM_SIZE))
             {
@@ -267,14 +297,14 @@ namespace embree
             const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
             const vbool<K> valid = vi < vint<K>(int(numOctantRays));
             const vint<K> index = *(vint<K>*)&rayIDs[j];
-            RayK<K>& ray = rays[j/K];
+            RayTypeK<K, intersect>& ray = rays[j/K];
             rayPtrs[j/K] = &ray;
             ray = rayN.getRayByIndex(valid, index);
             ray.tnear() = select(valid, ray.tnear(), zero);
             ray.tfar  = select(valid, ray.tfar,  neg_inf);
           }
 
-          scene->intersectors.occludedN(rayPtrs, numOctantRays, context);
+          scene->localIntersectors().intersectN(rayPtrs, numOctantRays, context);
 
           for (unsigned int j = 0; j < numOctantRays; j += K)
           {
@@ -287,22 +317,6 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
-      else
-      {
-        /* fallback to packets */
-        for (size_t i = 0; i < N; i += K)
-        {
-          const vint<K> vi = vint<K>(int(i)) + vint<K>(step);
-          vbool<K> valid = vi < vint<K>(int(N));
-
-          RayTypeK<K, intersect> ray = rayN.getRayByIndex(valid, vi);
-          valid &= ray.tnear() <= ray.tfar;
-
-          scene->intersectors.intersect(valid, ray, context);
-
-          rayN.setHitByIndex(valid, vi, ray);
-        }
-      }
     }
 
     template<int K, bool intersect>
@@ -331,7 +345,7 @@ namespace embree
             if (unlikely(packetIndex == MAX_INTERNAL_STREAM_SIZE / K))
             {
               const size_t size = packetIndex*K;
-              scene->intersectors.intersectN(rayPtrs, size, context);
+              scene->localIntersectors().intersectN(rayPtrs, size, context);
               packetIndex = 0;
             }
           }
@@ -340,17 +354,22 @@ namespace embree
           if (unlikely(packetIndex > 0))
           {
             const size_t size = packetIndex*K;
-            scene->intersectors.intersectN(rayPtrs, size, context);
+            scene->localIntersectors().intersectN(rayPtrs, size, context);
           }
         }
-        else if (unlikely(!intersect))
+        else
         {
-          /* octant sorting for occlusion rays */
+          /* octant sorting for incoherent rays */
           RayStreamSOA rayN(rayData, K);
 
           __aligned(64) unsigned int octants[8][MAX_INTERNAL_STREAM_SIZE];
-          __aligned(64) RayK<K> rays[MAX_INTERNAL_STREAM_SIZE / K];
-          __aligned(64) RayK<K>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+          __aligned(64) RayTypeK<K, intersect> rays[MAX_INTERNAL_STREAM_SIZE / K];
+          __aligned(64) RayTypeK<K, intersect>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+
+          /* optionally reorder large streams by origin and direction */
+          const size_t numRays = N*numPackets;
+          const bool reorder = context->isSortRays() && numRays > MAX_INTERNAL_STREAM_SIZE;
+          __aligned(64) unsigned int rayOrder[RAY_SORT_WINDOW];
 
           unsigned int raysInOctant[8];
           for (unsigned int i = 0; i < 8; i++)
@@ -362,9 +381,12 @@ namespace embree
             int curOctant = -1;
 
             /* sort rays into octants */
-            for (; inputRayID < N*numPackets;)
+            for (; inputRayID < numRays;)
             {
-              const size_t offset = (inputRayID / K) * stride + (inputRayID % K) * sizeof(float);
+              if (unlikely(reorder && inputRayID % RAY_SORT_WINDOW == 0))
+                sortRays(scene, inputRayID, min(numRays, inputRayID+RAY_SORT_WINDOW), rayOrder, [&] (size_t i) -> Ray { return rayN.getRayByOffset((i / K) * stride + (i % K) * sizeof(float)); });
+              const size_t rayID = reorder ? rayOrder[inputRayID % RAY_SORT_WINDOW] : inputRayID;
+              const size_t offset = (rayID / K) * stride + (rayID % K) * sizeof(float);
 
               /* skip invalid rays */
               if (unlikely(!rayN.isValidByOffset(offset))) { inputRayID++; continue; } // ignore invalid or already occluded rays
@@ -405,14 +427,14 @@ namespace embree
               const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
               const vbool<K> valid = vi < vint<K>(int(numOctantRays));
               const vint<K> offset = *(vint<K>*)&rayOffsets[j];
-              RayK<K>& ray = rays[j/K];
+              RayTypeK<K, intersect>& ray = rays[j/K];
               rayPtrs[j/K] = &ray;
               ray = rayN.getRayByOffset(valid, offset);
               ray.tnear() = select(valid, ray.tnear(), zero);
               ray.tfar  = select(valid, ray.tfar,  neg_inf);
             }
 
-            scene->intersectors.occludedN(rayPtrs, numOctantRays, context);
+            scene->localIntersectors().intersectN(rayPtrs, numOctantRays, context);
 
             for (unsigned int j = 0; j < numOctantRays; j += K)
             {
@@ -424,18 +446,6 @@ namespace embree
             raysInOctant[curOctant] = 0;
           }
         }
-        else
-        {
-          /* fallback to packets */
-          for (size_t i = 0; i < numPackets; i++)
-          {
-            const size_t offset = i * stride;
-            RayTypeK<K, intersect>& ray = *(RayTypeK<K, intersect>*)(rayData + offset);
-            const vbool<K> valid = ray.tnear() <= ray.tfar;
-
-            scene->intersectors.intersect(valid, ray, context);
-          }
-        }
       }
       else
       {
@@ -452,7 +462,7 @@ namespace embree
             RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
             valid &= ray.tnear() <= ray.tfar;
 
-            scene->intersectors.intersect(valid, ray, context);
+            scene->localIntersectors().intersect(valid, ray, context);
 
             rayN.setHitByOffset(valid, offset, ray);
           }
@@ -492,7 +502,7 @@ namespace embree
           }
 
           /* trace stream */
-          scene->intersectors.intersectN(rayPtrs, size, context);
+          scene->localIntersectors().intersectN(rayPtrs, size, context);
 
           /* convert from SOA to SOP */
           for (size_t j = 0; j < size; j += K)
@@ -506,12 +516,16 @@ namespace embree
           }
         }
       }
-      else if (unlikely(!intersect))
+      else
       {
-        /* octant sorting for occlusion rays */
+        /* octant sorting for incoherent rays */
         __aligned(64) unsigned int octants[8][MAX_INTERNAL_STREAM_SIZE];
-        __aligned(64) RayK<K> rays[MAX_INTERNAL_STREAM_SIZE / K];
-        __aligned(64) RayK<K>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+        __aligned(64) RayTypeK<K, intersect> rays[MAX_INTERNAL_STREAM_SIZE / K];
+        __aligned(64) RayTypeK<K, intersect>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+
+        /* optionally reorder large streams by origin and direction */
+        const bool reorder = context->isSortRays() && N > MAX_INTERNAL_STREAM_SIZE;
+        __aligned(64) unsigned int rayOrder[RAY_SORT_WINDOW];
 
         unsigned int raysInOctant[8];
         for (unsigned int i = 0; i < 8; i++)
@@ -525,7 +539,10 @@ namespace embree
           /* sort rays into octants */
           for (; inputRayID < N;)
           {
-            const size_t offset = inputRayID * sizeof(float);
+            if (unlikely(reorder && inputRayID % RAY_SORT_WINDOW == 0))
+              sortRays(scene, inputRayID, min(N, inputRayID+RAY_SORT_WINDOW), rayOrder, [&] (size_t i) -> Ray { return rayN.getRayByOffset(i * sizeof(float)); });
+            const size_t rayID = reorder ? rayOrder[inputRayID % RAY_SORT_WINDOW] : inputRayID;
+            const size_t offset = rayID * sizeof(float);
             /* skip invalid rays */
             if (unlikely(!rayN.isValidByOffset(offset))) { inputRayID++; continue; } // ignore invalid or already occluded rays
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
@@ -565,14 +582,14 @@ namespace embree
             const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
             const vbool<K> valid = vi < vint<K>(int(numOctantRays));
             const vint<K> offset = *(vint<K>*)&rayOffsets[j];
-            RayK<K>& ray = rays[j/K];
+            RayTypeK<K, intersect>& ray = rays[j/K];
             rayPtrs[j/K] = &ray;
             ray = rayN.getRayByOffset(valid, offset);
             ray.tnear() = select(valid, ray.tnear(), zero);
             ray.tfar  = select(valid, ray.tfar,  neg_inf);
           }
 
-          scene->intersectors.occludedN(rayPtrs, numOctantRays, context);
+          scene->localIntersectors().intersectN(rayPtrs, numOctantRays, context);
 
           for (unsigned int j = 0; j < numOctantRays; j += K)
           {
@@ -585,23 +602,6 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
-      else
-      {
-        /* fallback to packets */
-        for (size_t i = 0; i < N; i += K)
-        {
-          const vint<K> vi = vint<K>(int(i)) + vint<K>(step);
-          vbool<K> valid = vi < vint<K>(int(N));
-          const size_t offset = i * sizeof(float);
-
-          RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
-          valid &= ray.tnear() <= ray.tfar;
-
-          scene->intersectors.intersect(valid, ray, context);
-
-          rayN.setHitByOffset(valid, offset, ray);
-        }
-      }
     }
 
 
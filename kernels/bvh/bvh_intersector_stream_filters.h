@@ -38,6 +38,13 @@ namespace embree
       static void occludedSOP(Scene* scene, const RTCRayNp* rays, size_t N, IntersectContext* context);
 
     private:
+      /*! number of consecutive stream rays that get reordered together */
+      static const size_t RAY_SORT_WINDOW = 1024;
+
+      /*! calculates the order of the rays [begin,end) sorted by octant, origin, and direction */
+      template<typename GetRay>
+      static void sortRays(Scene* scene, size_t begin, size_t end, unsigned int* order, const GetRay& getRay);
+
       template<int K, bool intersect>
       static void filterAOS(Scene* scene, void* rays, size_t N, size_t stride, IntersectContext* context);
 
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "bvh_refit.h"
+#include "bvh_rotate.h"
 #include "bvh_statistics.h"
 
 #include "../geometry/linei.h"
@@ -29,6 +30,16 @@ namespace embree
   namespace isa
   {
     static const size_t SINGLE_THREAD_THRESHOLD = 4*1024;
+
+    /* SAH cost of a node or leaf, empty leaves cost nothing */
+    __forceinline double nodeSAH(const BBox3fa& bounds, size_t numBlocks) {
+      return bounds.empty() ? 0.0 : double(numBlocks)*double(halfArea(bounds));
+    }
+
+    /* SAH cost normalized by the root bounds */
+    __forceinline double normalizedSAH(double sah, const BBox3fa& bounds) {
+      return bounds.empty() ? 0.0 : sah/double(halfArea(bounds));
+    }
     
     template<int N>
     __forceinline bool compare(const typename BVHN<N>::NodeRef* a, const typename BVHN<N>::NodeRef* b)
@@ -40,33 +51,66 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), sah(0.0), numSubTrees(0)
     {
     }
 
     template<int N>
     void BVHNRefitter<N>::refit()
     {
+      double cost = 0.0;
+      BBox3fa bounds = empty;
       if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD) {
-        bvh->bounds = LBBox3fa(recurse_bottom(bvh->root));
+        bounds = recurse_bottom(bvh->root,cost);
       }
       else
       {
         BBox3fa subTreeBounds[MAX_NUM_SUB_TREES];
+        double subTreeSAH[MAX_NUM_SUB_TREES];
         numSubTrees = 0;
         gather_subtree_refs(bvh->root,numSubTrees,0);
         if (numSubTrees)
           parallel_for(size_t(0), numSubTrees, size_t(1), [&](const range<size_t>& r) {
               for (size_t i=r.begin(); i<r.end(); i++) {
                 NodeRef& ref = subTrees[i];
-                subTreeBounds[i] = recurse_bottom(ref);
+                subTreeSAH[i] = 0.0;
+                subTreeBounds[i] = recurse_bottom(ref,subTreeSAH[i]);
               }
             });
 
         numSubTrees = 0;        
-        bvh->bounds = LBBox3fa(refit_toplevel(bvh->root,numSubTrees,subTreeBounds,0));
+        bounds = refit_toplevel(bvh->root,numSubTrees,subTreeBounds,subTreeSAH,cost,0);
       }    
-  }
+      bvh->bounds = LBBox3fa(bounds);
+      sah = normalizedSAH(cost,bounds);
+    }
+
+    template<int N>
+    double BVHNRefitter<N>::computeSAH() const
+    {
+      const BBox3fa bounds = bvh->getBounds();
+      return normalizedSAH(recurse_sah(bvh->root,bounds),bounds);
+    }
+
+    template<int N>
+    double BVHNRefitter<N>::recurse_sah(NodeRef ref, const BBox3fa& bounds) const
+    {
+      if (ref.isLeaf()) {
+        size_t num; ref.leaf(num);
+        return nodeSAH(bounds,num);
+      }
+
+      double cost = nodeSAH(bounds,1);
+      if (ref.isAlignedNode())
+      {
+        AlignedNode* node = ref.alignedNode();
+        for (size_t i=0; i<N; i++) {
+          if (unlikely(node->child(i) == BVH::emptyNode)) continue;
+          cost += recurse_sah(node->child(i),node->bounds(i));
+        }
+      }
+      return cost;
+    }
 
     template<int N>
     void BVHNRefitter<N>::gather_subtree_refs(NodeRef& ref,
@@ -95,12 +139,15 @@ namespace embree
     BBox3fa BVHNRefitter<N>::refit_toplevel(NodeRef& ref,
                                             size_t &subtrees,
 											const BBox3fa *const subTreeBounds,
+                                            const double *const subTreeSAH,
+                                            double& sah,
                                             const size_t depth)
     {
       if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
       {
         assert(subtrees < MAX_NUM_SUB_TREES);
         assert(subTrees[subtrees] == ref);
+        sah += subTreeSAH[subtrees];
         return subTreeBounds[subtrees++];
       }
 
@@ -116,7 +163,7 @@ namespace embree
           if (unlikely(child == BVH::emptyNode)) 
             bounds[i] = BBox3fa(empty);
           else
-            bounds[i] = refit_toplevel(child,subtrees,subTreeBounds,depth+1); 
+            bounds[i] = refit_toplevel(child,subtrees,subTreeBounds,subTreeSAH,sah,depth+1); 
         }
         
         BBox3vf<N> boundsT = transpose<N>(bounds);
@@ -129,10 +176,17 @@ namespace embree
         node->upper_y = boundsT.upper.y;
         node->upper_z = boundsT.upper.z;
         
-        return merge<N>(bounds);
+        const BBox3fa merged = merge<N>(bounds);
+        sah += nodeSAH(merged,1);
+        return merged;
       }
       else
-        return leafBounds.leafBounds(ref);
+      {
+        size_t num; ref.leaf(num);
+        const BBox3fa bounds = leafBounds.leafBounds(ref);
+        sah += nodeSAH(bounds,num);
+        return bounds;
+      }
     }
 
     // =========================================================
@@ -141,11 +195,16 @@ namespace embree
 
     
     template<int N>
-    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref)
+    BBox3fa BVHNRefitter<N>::recurse_bottom(NodeRef& ref, double& sah)
     {
       /* this is a leaf node */
       if (unlikely(ref.isLeaf()))
-        return leafBounds.leafBounds(ref);
+      {
+        size_t num; ref.leaf(num);
+        const BBox3fa bounds = leafBounds.leafBounds(ref);
+        sah += nodeSAH(bounds,num);
+        return bounds;
+      }
       
       /* recurse if this is an internal node */
       AlignedNode* node = ref.alignedNode();
@@ -162,7 +221,7 @@ namespace embree
           bounds[i] = BBox3fa(empty);          
         }
       else
-        bounds[i] = recurse_bottom(node->child(i));
+        bounds[i] = recurse_bottom(node->child(i),sah);
       
       /* AOS to SOA transform */
       BBox3vf<N> boundsT = transpose<N>(bounds);
@@ -175,12 +234,14 @@ namespace embree
       node->upper_y = boundsT.upper.y;
       node->upper_z = boundsT.upper.z;
 
-      return merge<N>(bounds);
+      const BBox3fa merged = merge<N>(bounds);
+      sah += nodeSAH(merged,1);
+      return merged;
     }
 
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), buildSAH(0.0) {}
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
@@ -192,11 +253,26 @@ namespace embree
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::build()
     {
-      if (mesh->topologyChanged()) {
-        builder->build();
-      }
-      else
+      if (!mesh->topologyChanged() && buildSAH > 0.0)
+      {
+        BuildStatistics::PhaseTimer refitTimer(bvh->buildStats(),BuildStatistics::REFIT);
+        const double t0 = getSeconds();
         refitter->refit();
+
+        /* keep the refitted BVH as long as its SAH cost did not degrade too much */
+        const float ratio = mesh->device->refit_rebuild_ratio;
+        if (ratio <= 0.0f || refitter->sah <= double(ratio)*buildSAH)
+        {
+          /* improve the SAH of the refitted BVH using tree rotations within the time budget */
+          const float budget = mesh->device->tree_rotation_budget;
+          if (budget > 0.0f)
+            BVHNRotate<N>::optimize(bvh,double(budget)*(getSeconds()-t0));
+          return;
+        }
+      }
+        
+      builder->build();
+      buildSAH = refitter->computeSAH();
     }
 
     template class BVHNRefitter<4>;
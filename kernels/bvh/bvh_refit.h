@@ -44,6 +44,9 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! calculates the SAH cost of the BVH without refitting it */
+      double computeSAH() const;
+
     private:
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
@@ -54,14 +57,20 @@ namespace embree
       BBox3fa refit_toplevel(NodeRef& ref,
                              size_t &subtrees,
 							 const BBox3fa *const subTreeBounds,
+                             const double *const subTreeSAH,
+                             double& sah,
                              const size_t depth = 0);
 
       /* single-threaded subtree refit */
-      BBox3fa recurse_bottom(NodeRef& ref);
+      BBox3fa recurse_bottom(NodeRef& ref, double& sah);
+
+      /* single-threaded SAH calculation of a subtree */
+      double recurse_sah(NodeRef ref, const BBox3fa& bounds) const;
       
     public:
       BVH* bvh;                              //!< BVH to refit
       const LeafBoundsInterface& leafBounds; //!< calculates bounds of leaves
+      double sah;                            //!< SAH cost of the BVH after the last refit
 
       static const size_t MAX_SUB_TREE_EXTRACTION_DEPTH = (N==4) ? 4   : (N==8) ? 3    : 3;
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
@@ -86,6 +95,10 @@ namespace embree
       
       virtual void clear();
 
+      virtual size_t estimateMemory() {
+        return builder->estimateMemory();
+      }
+
       virtual const BBox3fa leafBounds (NodeRef& ref) const
       {
         size_t num; char* prim = ref.leaf(num);
@@ -102,6 +115,7 @@ namespace embree
       std::unique_ptr<Builder> builder;
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
+      double buildSAH; //!< SAH cost of the BVH after the last build, or 0 if unknown
     };
   }
 }
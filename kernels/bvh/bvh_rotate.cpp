@@ -27,7 +27,8 @@ namespace embree
       return a[0]+a[1]+a[2];
     }
     
-    size_t BVHNRotate<4>::rotate(NodeRef parentRef, size_t depth)
+    template<>
+    size_t BVHNRotate<4>::rotate(NodeRef parentRef, size_t depth, size_t& numRotations)
     {
       /*! nothing to rotate if we reached a leaf node. */
       if (parentRef.isBarrier()) return 0;
@@ -37,7 +38,7 @@ namespace embree
       /*! rotate all children first */
       vint4 cdepth;
       for (size_t c=0; c<4; c++)
-	cdepth[c] = (int)rotate(parent->child(c),depth+1);
+	cdepth[c] = (int)rotate(parent->child(c),depth+1,numRotations);
       
       /* compute current areas of all children */
       vfloat4 sizeX = parent->upper_x-parent->lower_x;
@@ -130,11 +131,143 @@ namespace embree
       parent->setBounds(bestChild2,child2->bounds());
       BVH4::compact(parent);
       BVH4::compact(child2);
+      numRotations++;
       
       /*! This returned depth is conservative as the child that was
        *  pulled up in the tree could have been on the critical path. */
       cdepth[bestChild1]++; // bestChild1 was pushed down one level
       return 1+reduce_max(cdepth); 
     }
+
+    template<int N>
+    size_t BVHNRotate<N>::rotate(NodeRef parentRef, size_t depth, size_t& numRotations)
+    {
+      /*! nothing to rotate if we reached a leaf node. */
+      if (parentRef.isBarrier()) return 0;
+      if (parentRef.isLeaf()) return 0;
+      AlignedNode* parent = parentRef.alignedNode();
+      
+      /*! rotate all children first */
+      size_t cdepth[N];
+      for (size_t c=0; c<N; c++)
+        cdepth[c] = rotate(parent->child(c),depth+1,numRotations);
+
+      /*! Find best rotation. We pick a first child (child1) and a sub-child 
+	(child2child) of a different second child (child2), and swap child1 
+	and child2child. We perform the best such swap. */
+      float bestArea = 0;
+      size_t bestChild1 = -1, bestChild2 = -1, bestChild2Child = -1;
+      for (size_t c2=0; c2<N; c2++)
+      {
+        /*! ignore leaf nodes as we cannot descent into them */
+        if (parent->child(c2).isBarrier()) continue;
+        if (parent->child(c2).isLeaf()) continue;
+        AlignedNode* child2 = parent->child(c2).alignedNode();
+        const float child2Area = halfArea(parent->bounds(c2));
+
+        /*! bounds of child2 without one of its children are merged from prefix and suffix bounds */
+        BBox3fa prefix[N+1], suffix[N+1];
+        prefix[0] = suffix[N] = empty;
+        for (size_t i=0; i<N; i++) prefix[i+1] = merge(prefix[i],child2->bounds(i));
+        for (size_t i=N; i>0; i--) suffix[i-1] = merge(suffix[i],child2->bounds(i-1));
+
+        for (size_t c1=0; c1<N; c1++)
+        {
+          if (c1 == c2 || parent->child(c1) == BVH::emptyNode) continue;
+          if (depth+1+cdepth[c1] > BVH::maxBuildDepth) continue; // only select swaps that fulfill depth constraints
+          const BBox3fa child1 = parent->bounds(c1);
+
+          /*! put child1 at each child2 position */
+          for (size_t pos=0; pos<N; pos++)
+          {
+            if (child2->child(pos) == BVH::emptyNode) continue;
+            const float area = halfArea(merge(prefix[pos],suffix[pos+1],child1)) - child2Area;
+
+            /*! accept a swap when it reduces cost */
+            if (area < bestArea) {
+              bestArea = area;
+              bestChild1 = c1;
+              bestChild2 = c2;
+              bestChild2Child = pos;
+            }
+          }
+        }
+      }
+
+      size_t maxDepth = 0;
+      for (size_t c=0; c<N; c++) maxDepth = max(maxDepth,cdepth[c]);
+      
+      /*! if we did not find a swap that improves the SAH then do nothing */
+      if (bestChild1 == size_t(-1)) return 1+maxDepth;
+      
+      /*! perform the best found tree rotation */
+      AlignedNode* child2 = parent->child(bestChild2).alignedNode();
+      BVH::swap(parent,bestChild1,child2,bestChild2Child);
+      parent->setBounds(bestChild2,child2->bounds());
+      BVH::compact(parent);
+      BVH::compact(child2);
+      numRotations++;
+      
+      /*! This returned depth is conservative as the child that was
+       *  pulled up in the tree could have been on the critical path. */
+      return 1+max(maxDepth,cdepth[bestChild1]+1); // bestChild1 was pushed down one level
+    }
+
+    /* gathers the subtrees at some depth for parallel rotations */
+    template<int N>
+    static void gatherSubTrees(typename BVHN<N>::NodeRef& ref, size_t depth, std::vector<std::pair<typename BVHN<N>::NodeRef*,size_t>>& subtrees)
+    {
+      if (ref.isLeaf()) return;
+      if (depth == ((N == 4) ? 4 : 3)) {
+        subtrees.push_back(std::make_pair(&ref,depth+1));
+        return;
+      }
+      typename BVHN<N>::AlignedNode* node = ref.alignedNode();
+      for (size_t i=0; i<N; i++)
+        gatherSubTrees<N>(node->child(i),depth+1,subtrees);
+    }
+
+    template<int N>
+    size_t BVHNRotate<N>::optimize(BVH* bvh, double budget)
+    {
+      const double deadline = getSeconds()+budget;
+      size_t rounds = 0;
+      while (getSeconds() < deadline)
+      {
+        rounds++;
+        std::atomic<size_t> numRotations(0);
+
+#if defined(__X86_64__)
+        /* rotate subtrees in parallel as long as there is time left */
+        std::vector<std::pair<NodeRef*,size_t>> subtrees;
+        gatherSubTrees<N>(bvh->root,0,subtrees);
+        parallel_for(size_t(0), subtrees.size(), size_t(1), [&](const range<size_t>& r) {
+            size_t n = 0;
+            for (size_t i=r.begin(); i<r.end(); i++)
+              if (getSeconds() < deadline)
+                rotate(*subtrees[i].first,subtrees[i].second,n);
+            numRotations += n;
+          });
+
+        /* rotate the top of the tree, the barriers stop the rotations at the subtrees */
+        for (auto& subtree : subtrees) subtree.first->setBarrier();
+        size_t n = 0;
+        rotate(bvh->root,1,n);
+        numRotations += n;
+        bvh->clearBarrier(bvh->root);
+#else
+        size_t n = 0;
+        rotate(bvh->root,1,n);
+        numRotations += n;
+#endif
+        if (numRotations == 0) break;
+      }
+      return rounds;
+    }
+
+    template class BVHNRotate<4>;
+#if defined(__AVX__)
+    template class BVHNRotate<8>;
+#endif
   }
 }
@@ -25,26 +25,26 @@ namespace embree
     template<int N>
     class BVHNRotate
     {
-      typedef typename BVHN<N>::NodeRef NodeRef;
+      typedef BVHN<N> BVH;
+      typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVH::NodeRef NodeRef;
 
     public:
-      static const bool enabled = false;
+      static const bool enabled = true;
 
-      static __forceinline size_t rotate(NodeRef parentRef, size_t depth = 1) { return 0; }
-      static __forceinline void restructure(NodeRef ref, size_t depth = 1) {}
-    };
+      /*! performs the best tree rotation at each node of the subtree, returns the depth of the subtree */
+      static __forceinline size_t rotate(NodeRef parentRef, size_t depth = 1) {
+        size_t numRotations = 0; return rotate(parentRef,depth,numRotations);
+      }
 
-    /* BVH4 tree rotations */
-    template<>
-    class BVHNRotate<4>
-    {
-      typedef BVH4::AlignedNode AlignedNode;
-      typedef BVH4::NodeRef NodeRef;
-      
-    public:
-      static const bool enabled = true;
+      /*! performs the best tree rotation at each node of the subtree and counts the rotations performed */
+      static size_t rotate(NodeRef parentRef, size_t depth, size_t& numRotations);
 
-      static size_t rotate(NodeRef parentRef, size_t depth = 1);
+      /*! performs rounds of tree rotations until no rotation improves the SAH anymore or the time budget (in seconds) is used up */
+      static size_t optimize(BVH* bvh, double budget);
     };
+
+    /* BVH4 tree rotations */
+    template<> size_t BVHNRotate<4>::rotate(NodeRef parentRef, size_t depth, size_t& numRotations);
   }
 }
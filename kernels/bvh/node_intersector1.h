@@ -53,7 +53,7 @@ namespace embree
         farY  = nearY ^ sizeof(vfloat<N>);
         farZ  = nearZ ^ sizeof(vfloat<N>);
 
-#if defined(__AVX512ER__) // KNL+
+#if defined(__AVX512F__) // KNL+, SKX
         /* optimization works only for 8-wide BVHs with 16-wide SIMD */
         const vint<16> id(step);
         const vint<16> id2 = align_shift_right<16/2>(id, id);
@@ -82,7 +82,7 @@ namespace embree
         farY  = nearY ^ flip;
         farZ  = nearZ ^ flip;
 
-#if defined(__AVX512ER__) // KNL+
+#if defined(__AVX512F__) // KNL+, SKX
         /* optimization works only for 8-wide BVHs with 16-wide SIMD */
         const vint<16> id(step);
         const vint<16> id2 = align_shift_right<16/2>(id, id);
@@ -97,7 +97,7 @@ namespace embree
 #if defined(__AVX2__)
       Vec3vf<Nx> org_rdir;
 #endif
-#if defined(__AVX512ER__) // KNL+
+#if defined(__AVX512F__) // KNL+, SKX
       vint16 permX, permY, permZ;
 #endif
 
@@ -250,6 +250,21 @@ namespace embree
     template<>
       __forceinline size_t intersectNode<8,8>(const typename BVH8::AlignedNode* node, const TravRay<8,8,false>& ray, vfloat8& dist)
     {
+#if defined(__AVX512VL__) // SKX
+      /* the near and far planes of all 8 children get intersected together using 16-wide SIMD */
+      const vfloat16 bminmaxX  = permute(vfloat16::load((const float*)&node->lower_x), ray.permX);
+      const vfloat16 bminmaxY  = permute(vfloat16::load((const float*)&node->lower_y), ray.permY);
+      const vfloat16 bminmaxZ  = permute(vfloat16::load((const float*)&node->lower_z), ray.permZ);
+      const vfloat16 tNearFarX = msub(bminmaxX, vfloat16(ray.rdir.x), vfloat16(ray.org_rdir.x));
+      const vfloat16 tNearFarY = msub(bminmaxY, vfloat16(ray.rdir.y), vfloat16(ray.org_rdir.y));
+      const vfloat16 tNearFarZ = msub(bminmaxZ, vfloat16(ray.rdir.z), vfloat16(ray.org_rdir.z));
+      const vfloat16 tNear     = max(tNearFarX, tNearFarY, tNearFarZ, vfloat16(ray.tnear));
+      const vfloat16 tFar      = min(tNearFarX, tNearFarY, tNearFarZ, vfloat16(ray.tfar));
+      const vbool16 vmask      = le(vbool16(0xff),tNear,align_shift_right<8>(tFar, tFar));
+      const size_t mask        = movemask(vmask);
+      dist = extract8<0>(tNear);
+      return mask;
+#else
 #if defined(__AVX2__)
       const vfloat8 tNearX = msub(vfloat8::load((float*)((const char*)&node->lower_x+ray.nearX)), ray.rdir.x, ray.org_rdir.x);
       const vfloat8 tNearY = msub(vfloat8::load((float*)((const char*)&node->lower_x+ray.nearY)), ray.rdir.y, ray.org_rdir.y);
@@ -271,11 +286,6 @@ namespace embree
       const vfloat8 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
       const vbool8 vmask = asInt(tNear) > asInt(tFar);
       const size_t mask = movemask(vmask) ^ ((1<<8)-1);
-#elif defined(__AVX512F__) && !defined(__AVX512ER__) // SKX
-      const vfloat8 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
-      const vfloat8 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
-      const vbool8 vmask = asInt(tNear) <= asInt(tFar);
-      const size_t mask = movemask(vmask);
 #else
       const vfloat8 tNear = max(tNearX,tNearY,tNearZ,ray.tnear);
       const vfloat8 tFar  = min(tFarX ,tFarY ,tFarZ ,ray.tfar);
@@ -284,6 +294,7 @@ namespace embree
 #endif
       dist = tNear;
       return mask;
+#endif
     }
 
 #endif
@@ -1201,6 +1212,72 @@ namespace embree
 
     };
 
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Point query distance to the children of a node
+    //////////////////////////////////////////////////////////////////////////////////////
+
+    template<int N>
+      __forceinline vfloat<N> pointQueryDistance(const vfloat<N>& lower_x, const vfloat<N>& lower_y, const vfloat<N>& lower_z,
+                                                 const vfloat<N>& upper_x, const vfloat<N>& upper_y, const vfloat<N>& upper_z,
+                                                 const Vec3vf<N>& p)
+    {
+      const vfloat<N> dx = max(lower_x-p.x,p.x-upper_x,vfloat<N>(zero));
+      const vfloat<N> dy = max(lower_y-p.y,p.y-upper_y,vfloat<N>(zero));
+      const vfloat<N> dz = max(lower_z-p.z,p.z-upper_z,vfloat<N>(zero));
+      return madd(dx,dx,madd(dy,dy,dz*dz));
+    }
+
+    /*! Calculates the squared distance of a query point to the N children of a node. */
+    template<int N, int types>
+    struct BVHNNodePointQuery1
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const Vec3vf<N>& p, const float time, const float radius2, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
 
+        vbool<N> vmask;
+        if (likely(node.isAlignedNode()))
+        {
+          const typename BVHN<N>::AlignedNode* n = node.alignedNode();
+          dist = pointQueryDistance(n->lower_x,n->lower_y,n->lower_z,n->upper_x,n->upper_y,n->upper_z,p);
+          vmask = n->lower_x <= n->upper_x;
+        }
+        else if ((types & (BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D)) && (node.isAlignedNodeMB() || node.isAlignedNodeMB4D()))
+        {
+          const typename BVHN<N>::AlignedNodeMB* n = node.alignedNodeMB();
+          const vfloat<N> lower_x = madd(time,n->lower_dx,n->lower_x);
+          const vfloat<N> lower_y = madd(time,n->lower_dy,n->lower_y);
+          const vfloat<N> lower_z = madd(time,n->lower_dz,n->lower_z);
+          const vfloat<N> upper_x = madd(time,n->upper_dx,n->upper_x);
+          const vfloat<N> upper_y = madd(time,n->upper_dy,n->upper_y);
+          const vfloat<N> upper_z = madd(time,n->upper_dz,n->upper_z);
+          dist = pointQueryDistance(lower_x,lower_y,lower_z,upper_x,upper_y,upper_z,p);
+          vmask = lower_x <= upper_x;
+          if (unlikely(node.isAlignedNodeMB4D())) {
+            const typename BVHN<N>::AlignedNodeMB4D* n1 = (const typename BVHN<N>::AlignedNodeMB4D*) n;
+            vmask &= (n1->lower_t <= time) & (time < n1->upper_t);
+          }
+        }
+        else if ((types & BVH_FLAG_QUANTIZED_NODE) && node.isQuantizedNode())
+        {
+          const typename BVHN<N>::QuantizedNode* n = node.quantizedNode();
+          dist = pointQueryDistance(n->dequantizeLowerX(),n->dequantizeLowerY(),n->dequantizeLowerZ(),
+                                    n->dequantizeUpperX(),n->dequantizeUpperY(),n->dequantizeUpperZ(),p);
+          vmask = n->validMask();
+        }
+        else
+        {
+          /* the space of unaligned nodes does not preserve distances, thus all children get traversed */
+          const typename BVHN<N>::BaseNode* n = node.baseNode(types);
+          dist = zero;
+          mask = 0;
+          for (size_t i=0; i<N && n->child(i) != BVHN<N>::emptyNode; i++)
+            mask |= size_t(1) << i;
+          return true;
+        }
+        mask = movemask(vmask & (dist <= vfloat<N>(radius2)));
+        return true;
+      }
+    };
   }
 }
@@ -637,6 +637,28 @@ namespace embree
       }
     };
 
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN1, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKFast<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectQuantizedNodeK<N,K>(node.quantizedNode(), i, ray, dist);
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN1, true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKRobust<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectQuantizedNodeK<N,K>(node.quantizedNode(), i, ray, dist);
+        return true;
+      }
+    };
+
     template<int N, int K>
     struct BVHNNodeIntersectorK<N, K, BVH_AN2, false>
     {
@@ -24,6 +24,52 @@ namespace embree
 {
   class Scene;
 
+  /*! Memory mapped file of serialized acceleration structures. The
+   *  file is a sequence of chunks, each starting at a multiple of
+   *  chunkAlignment bytes, thus chunks can get used in place. The
+   *  mapping is private, relocating pointers only touches copies of
+   *  the written pages. */
+  class AccelFile : public RefCount
+  {
+  public:
+    static const size_t chunkAlignment = 64;
+
+    AccelFile (const std::string& fileName)
+      : ptr(nullptr), bytes(0), cur(0)
+    {
+      ptr = (char*) os_map_file(fileName.c_str(),bytes);
+      if (ptr == nullptr)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"cannot open file "+fileName);
+    }
+
+    ~AccelFile () {
+      os_unmap_file(ptr,bytes);
+    }
+
+    /*! returns next chunk of the file */
+    char* next(size_t chunkBytes)
+    {
+      if (chunkBytes > bytes || cur > bytes-chunkBytes)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"corrupted acceleration structure file");
+      char* chunk = ptr+cur;
+      cur = (cur+chunkBytes+chunkAlignment-1) & ~(chunkAlignment-1);
+      return chunk;
+    }
+
+    /*! writes a chunk and pads the stream to the chunk alignment */
+    static void write(std::ostream& out, const void* data, size_t chunkBytes)
+    {
+      static const char zeros[chunkAlignment] = { 0 };
+      out.write((const char*)data,chunkBytes);
+      out.write(zeros,(chunkAlignment-chunkBytes%chunkAlignment)%chunkAlignment);
+    }
+
+  public:
+    char* ptr;     //!< start of mapped file
+    size_t bytes;  //!< size of mapped file
+    size_t cur;    //!< offset of next chunk
+  };
+
   /*! Base class for the acceleration structure data. */
   class AccelData : public RefCount 
   {
@@ -41,6 +87,24 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! writes the acceleration structure in a relocatable format */
+    virtual void save(std::ostream& out) const {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure cannot get saved");
+    }
+
+    /*! loads the acceleration structure from the next chunks of a file */
+    virtual void load(AccelFile* file) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure cannot get loaded");
+    }
+
+    /*! creates a copy of the inner nodes in memory local to the calling thread, returns nullptr if not supported */
+    virtual AccelData* replicate() {
+      return nullptr;
+    }
+
+    /*! adds the bytes allocated and used by the acceleration structure to the counters */
+    virtual void addMemoryUsage(size_t& bytesAllocated, size_t& bytesUsed) {}
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -122,15 +186,20 @@ namespace embree
                                   RTCRayN** ray,      /*!< ray stream to test occlusion */
                                   const size_t N,     /*!< number of rays in stream */
                                   IntersectContext* context /*!< layout flags */);
+
+    /*! Type of point query function pointer. */
+    typedef bool (*PointQueryFunc)(Intersectors* This,       /*!< this pointer to accel */
+                                   RTCPointQuery* query,     /*!< point query */
+                                   PointQueryContext* context);
     typedef void (*ErrorFunc) ();
 
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), pointQuery((PointQueryFunc)error), name(nullptr) {}
       
-      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), name(name) {}
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
 
       operator bool() const { return name; }
 
@@ -138,6 +207,7 @@ namespace embree
       static const char* type;
       IntersectFunc intersect;
       OccludedFunc occluded;  
+      PointQueryFunc pointQuery;
       const char* name;
     };
     
@@ -270,19 +340,28 @@ namespace embree
       /*! Intersects a packet of 4 rays with the scene. */
       __forceinline void intersect4 (const void* valid, RTCRayHit4& ray, IntersectContext* context) {
         assert(intersector4.intersect);
-        intersector4.intersect(valid,this,ray,context);
+        if (unlikely(context->collector && intersector4_filter)) // hit collection requires the filter path
+          intersector4_filter.intersect(valid,this,ray,context);
+        else
+          intersector4.intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 8 rays with the scene. */
       __forceinline void intersect8 (const void* valid, RTCRayHit8& ray, IntersectContext* context) {
         assert(intersector8.intersect);
-        intersector8.intersect(valid,this,ray,context);
+        if (unlikely(context->collector && intersector8_filter)) // hit collection requires the filter path
+          intersector8_filter.intersect(valid,this,ray,context);
+        else
+          intersector8.intersect(valid,this,ray,context);
       }
       
       /*! Intersects a packet of 16 rays with the scene. */
       __forceinline void intersect16 (const void* valid, RTCRayHit16& ray, IntersectContext* context) {
         assert(intersector16.intersect);
-        intersector16.intersect(valid,this,ray,context);
+        if (unlikely(context->collector && intersector16_filter)) // hit collection requires the filter path
+          intersector16_filter.intersect(valid,this,ray,context);
+        else
+          intersector16.intersect(valid,this,ray,context);
       }
       
       /*! Intersects a stream of N rays in SOA layout with the scene. */
@@ -322,6 +401,12 @@ namespace embree
         assert(intersector1.occluded);
         intersector1.occluded(this,ray,context);
       }
+
+      /*! Traverses the scene with a point query, returns true if the query got modified. */
+      __forceinline bool pointQuery (RTCPointQuery* query, PointQueryContext* context) {
+        assert(intersector1.pointQuery);
+        return intersector1.pointQuery(this,query,context);
+      }
       
       /*! Tests if a packet of 4 rays is occluded by the scene. */
       __forceinline void occluded4 (const void* valid, RTCRay4& ray, IntersectContext* context) {
@@ -427,15 +512,26 @@ namespace embree
     /*! build acceleration structure */
     virtual void build () = 0;
 
+    /*! creates a copy of the inner nodes in memory local to the calling thread, returns nullptr if not supported */
+    virtual Accel* replicate() {
+      return nullptr;
+    }
+
+    /*! returns the predicted peak memory consumption of the next build in bytes, or 0 if unknown */
+    virtual size_t estimateMemory() {
+      return 0;
+    }
+
   public:
     Intersectors intersectors;
   };
 
-#define DEFINE_INTERSECTOR1(symbol,intersector)                              \
-  Accel::Intersector1 symbol() {                                             \
-    return Accel::Intersector1((Accel::IntersectFunc)intersector::intersect, \
-                               (Accel::OccludedFunc )intersector::occluded,  \
-                               TOSTRING(isa) "::" TOSTRING(symbol));         \
+#define DEFINE_INTERSECTOR1(symbol,intersector)                                 \
+  Accel::Intersector1 symbol() {                                                \
+    return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect,   \
+                               (Accel::OccludedFunc  )intersector::occluded,    \
+                               (Accel::PointQueryFunc)intersector::pointQuery,  \
+                               TOSTRING(isa) "::" TOSTRING(symbol));            \
   }
   
 #define DEFINE_INTERSECTOR4(symbol,intersector)                               \
@@ -37,6 +37,35 @@ namespace embree
       bounds = accel->bounds;
     }
 
+    void save(std::ostream& out) const {
+      accel->save(out);
+    }
+
+    void load(AccelFile* file) {
+      accel->load(file);
+      bounds = accel->bounds;
+    }
+
+    Accel* replicate()
+    {
+      if (intersectors.ptr != accel.get()) return nullptr;
+      AccelData* replica = accel->replicate();
+      if (!replica) return nullptr;
+      Intersectors replicaIntersectors = intersectors;
+      replicaIntersectors.ptr = replica;
+      AccelInstance* r = new AccelInstance(replica,nullptr,replicaIntersectors);
+      r->bounds = bounds;
+      return r;
+    }
+
+    size_t estimateMemory() {
+      return builder ? builder->estimateMemory() : 0;
+    }
+
+    void addMemoryUsage(size_t& bytesAllocated, size_t& bytesUsed) {
+      accel->addMemoryUsage(bytesAllocated,bytesUsed);
+    }
+
     void deleteGeometry(size_t geomID) {
       if (accel  ) accel->deleteGeometry(geomID);
       if (builder) builder->deleteGeometry(geomID);
@@ -147,6 +147,15 @@ namespace embree
       This->validAccels[i]->intersectors.occludedN(ray,M,context);
   }
 
+  bool AccelN::pointQuery (Accel::Intersectors* This_in, RTCPointQuery* query, PointQueryContext* context)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    bool changed = false;
+    for (size_t i=0; i<This->validAccels.size(); i++)
+      changed |= This->validAccels[i]->intersectors.pointQuery(query,context);
+    return changed;
+  }
+
   void AccelN::print(size_t ident)
   {
     for (size_t i=0; i<validAccels.size(); i++)
@@ -170,6 +179,59 @@ namespace embree
         accels[i]->build();
       });
 
+    selectValidAccels();
+  }
+
+  void AccelN::save(std::ostream& out) const
+  {
+    const size_t numAccels = accels.size();
+    AccelFile::write(out,&numAccels,sizeof(numAccels));
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->save(out);
+  }
+
+  void AccelN::load(AccelFile* file)
+  {
+    const size_t numAccels = *(size_t*) file->next(sizeof(size_t));
+    if (numAccels != accels.size())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure file does not match scene");
+
+    /* chunks of the file have to get consumed in order */
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->load(file);
+
+    selectValidAccels();
+  }
+
+  AccelN* AccelN::replicate()
+  {
+    std::unique_ptr<AccelN> replica(new AccelN);
+    for (size_t i=0; i<accels.size(); i++) {
+      Accel* accel = accels[i]->replicate();
+      if (!accel) return nullptr;
+      replica->add(accel);
+    }
+    replica->selectValidAccels();
+    return replica.release();
+  }
+
+  size_t AccelN::estimateMemory()
+  {
+    /* all acceleration structures get built in parallel */
+    size_t bytes = 0;
+    for (size_t i=0; i<accels.size(); i++)
+      bytes += accels[i]->estimateMemory();
+    return bytes;
+  }
+
+  void AccelN::addMemoryUsage(size_t& bytesAllocated, size_t& bytesUsed)
+  {
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->addMemoryUsage(bytesAllocated,bytesUsed);
+  }
+
+  void AccelN::selectValidAccels()
+  {
     /* create list of non-empty acceleration structures */
     validAccels.clear();
     bool valid1 = true;
@@ -191,7 +253,7 @@ namespace embree
     else 
     {
       intersectors.ptr = this;
-      intersectors.intersector1  = Intersector1(&intersect,&occluded,valid1 ? "AccelN::intersector1": nullptr);
+      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,valid1 ? "AccelN::intersector1": nullptr);
       intersectors.intersector4  = Intersector4(&intersect4,&occluded4,valid4 ? "AccelN::intersector4" : nullptr);
       intersectors.intersector8  = Intersector8(&intersect8,&occluded8,valid8 ? "AccelN::intersector8" : nullptr);
       intersectors.intersector16 = Intersector16(&intersect16,&occluded16,valid16 ? "AccelN::intersector16": nullptr);
@@ -45,14 +45,25 @@ namespace embree
     static void occluded16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context);
     static void occludedN (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context);
 
+  public:
+    static bool pointQuery (Accel::Intersectors* This, RTCPointQuery* query, PointQueryContext* context);
+
   public:
     void print(size_t ident);
     void immutable();
     void build ();
+    void save(std::ostream& out) const;
+    void load(AccelFile* file);
     void select(bool filter);
+    AccelN* replicate();
+    size_t estimateMemory();
+    void addMemoryUsage(size_t& bytesAllocated, size_t& bytesUsed);
     void deleteGeometry(size_t geomID);
     void clear ();
 
+  private:
+    void selectValidAccels();
+
   public:
     darray_t<Accel*,24> accels;
     darray_t<Accel*,24> validAccels;
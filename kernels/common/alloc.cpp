@@ -87,6 +87,39 @@ namespace embree
   };
 
   fast_allocator_regression_test fast_allocator_regression;
+
+  /* checks that rebuilds of the same size reuse the blocks of previous builds */
+  struct fast_allocator_recycle_regression_test : public RegressionTest
+  {
+    fast_allocator_recycle_regression_test() 
+      : RegressionTest("fast_allocator_recycle_regression_test")
+    {
+      registerRegressionTest(this);
+    }
+
+    bool run ()
+    {
+      std::unique_ptr<FastAllocator> alloc = make_unique(new FastAllocator(nullptr,false));
+
+      bool passed = true;
+      size_t bytesAllocated = 0;
+      for (size_t j=0; j<100; j++)
+      {
+        alloc->reset();
+        FastAllocator::CachedAllocator threadalloc = alloc->getCachedAllocator();
+        for (size_t i=0; i<10000; i++)
+          threadalloc.malloc0(64+(i%32));
+        alloc->cleanup();
+
+        const size_t bytes = alloc->getStatistics(FastAllocator::ANY_TYPE).bytesAllocatedTotal();
+        if (j == 0) bytesAllocated = bytes;
+        passed &= bytes == bytesAllocated;
+      }
+      return passed;
+    }
+  };
+
+  fast_allocator_recycle_regression_test fast_allocator_recycle_regression;
 }
 
 
@@ -23,6 +23,71 @@
 
 namespace embree
 {
+  /*! Pool of pre-faulted OS allocated memory blocks of a device. Freed
+   *  blocks are kept up to a maximal size and are handed out again to
+   *  later allocations of the same size, thus builds of all scenes of
+   *  the device avoid page faults and repeated mmap calls. */
+  class ArenaPool
+  {
+    struct Entry
+    {
+      Entry (void* ptr, bool huge_pages)
+        : ptr(ptr), huge_pages(huge_pages) {}
+
+      void* ptr;
+      bool huge_pages;
+    };
+
+  public:
+
+    ArenaPool (size_t maxBytes)
+      : maxBytes(maxBytes), bytes(0) {}
+
+    ~ArenaPool ()
+    {
+      for (auto& entry : entries)
+        os_free(entry.second.ptr,entry.first,entry.second.huge_pages);
+    }
+
+    /*! returns a pooled block of exactly the requested size or allocates a new pre-faulted one */
+    void* malloc(size_t bytes_in, bool& huge_pages)
+    {
+      {
+        Lock<MutexSys> lock(mutex);
+        auto entry = entries.find(bytes_in);
+        if (entry != entries.end())
+        {
+          void* ptr = entry->second.ptr;
+          huge_pages = entry->second.huge_pages;
+          entries.erase(entry);
+          bytes -= bytes_in;
+          return ptr;
+        }
+      }
+      return os_malloc(bytes_in,huge_pages,true);
+    }
+
+    /*! keeps the block for reuse or returns it to the OS when the pool is full */
+    void free(void* ptr, size_t bytes_in, bool huge_pages)
+    {
+      {
+        Lock<MutexSys> lock(mutex);
+        if (bytes+bytes_in <= maxBytes) {
+          entries.insert(std::make_pair(bytes_in,Entry(ptr,huge_pages)));
+          bytes += bytes_in;
+          return;
+        }
+      }
+      os_free(ptr,bytes_in,huge_pages);
+    }
+
+  private:
+    MutexSys mutex;
+    std::multimap<size_t,Entry> entries; //!< pooled blocks by size
+    const size_t maxBytes;               //!< maximal number of pooled bytes
+    size_t bytes;                        //!< currently pooled bytes
+  };
+
   class FastAllocator
   {
     /*! maximum supported alignment */
@@ -36,6 +101,8 @@ namespace embree
 
     static const size_t MAX_THREAD_USED_BLOCK_SLOTS = 8;
 
+    struct Block;
+
   public:
 
     struct ThreadLocal2;
@@ -182,13 +249,14 @@ namespace embree
 
     FastAllocator (Device* device, bool osAllocation) 
       : device(device), slotMask(0), usedBlocks(nullptr), freeBlocks(nullptr), use_single_mode(false), defaultBlockSize(PAGE_SIZE), estimatedSize(0),
-        growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), atype(osAllocation ? OS_MALLOC : ALIGNED_MALLOC),
+        growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), atype(osAllocation || useArena(device) ? OS_MALLOC : ALIGNED_MALLOC),
         primrefarray(device,0)
     {
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
         threadUsedBlocks[i] = nullptr;
         threadBlocks[i] = nullptr;
+        threadFreeBlocks[i] = nullptr;
         assert(!slotMutex[i].isLocked());
       }
     }
@@ -217,7 +285,12 @@ namespace embree
 
     void setOSallocation(bool flag)
     {
-      atype = flag ? OS_MALLOC : ALIGNED_MALLOC;
+      atype = flag || useArena(device) ? OS_MALLOC : ALIGNED_MALLOC;
+    }
+
+    /*! large blocks come from the arena pool of the device if enabled */
+    static bool useArena(Device* device) {
+      return device && device->arena_pool;
     }
 
   private:
@@ -305,6 +378,38 @@ namespace embree
         }
         threadBlocks[i] = nullptr;
       }
+
+      /* move recycled blocks not used by this build back to global free list */
+      for (size_t i = 0; i < MAX_THREAD_USED_BLOCK_SLOTS; i++)
+      {
+        while (threadFreeBlocks[i].load() != nullptr) {
+          Block* nextFreeBlock = threadFreeBlocks[i].load()->next;
+          threadFreeBlocks[i].load()->next = freeBlocks.load();
+          freeBlocks = threadFreeBlocks[i].load();
+          threadFreeBlocks[i] = nextFreeBlock;
+        }
+      }
+    }
+
+    /*! lock-free push of a block to a block list */
+    static __forceinline void push_block(std::atomic<Block*>& list, Block* block)
+    {
+      Block* head = list.load();
+      do { block->next = head; } while (!list.compare_exchange_weak(head,block));
+    }
+
+    /*! lock-free pop of a recycled block, preferably one the slot used in the last build. As
+     *  recycled blocks only get pushed in reset, no ABA problem can occur during the build. */
+    __forceinline Block* pop_free_block(size_t slot)
+    {
+      for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
+      {
+        std::atomic<Block*>& list = threadFreeBlocks[(slot+i)%MAX_THREAD_USED_BLOCK_SLOTS];
+        Block* block = list.load();
+        while (block && !list.compare_exchange_weak(block,block->next));
+        if (block) return block;
+      }
+      return nullptr;
     }
 
     static const size_t threadLocalAllocOverhead = 20; //! 20 means 5% parallel allocation overhead through unfilled thread local blocks
@@ -439,18 +544,27 @@ namespace embree
       bytesFree.store(0);
       bytesWasted.store(0);
 
-      /* reset all used blocks and move them to begin of free block list */
-      while (usedBlocks.load() != nullptr) {
-        usedBlocks.load()->reset_block();
-        Block* nextUsedBlock = usedBlocks.load()->next;
-        usedBlocks.load()->next = freeBlocks.load();
-        freeBlocks = usedBlocks.load();
-        usedBlocks = nextUsedBlock;
+      /* reset all blocks and recycle blocks of thread slots to the same slot, such that
+       * threads get warm blocks without taking the global mutex during the next build */
+      Block* oldFreeBlocks = freeBlocks.exchange(nullptr);
+      Block* oldUsedBlocks = usedBlocks.exchange(nullptr);
+      for (Block* block : { oldFreeBlocks, oldUsedBlocks })
+      {
+        while (block != nullptr)
+        {
+          Block* nextBlock = block->next;
+
+          /* shared blocks get removed as they are re-added during build */
+          if (block->atype != SHARED) {
+            block->reset_block();
+            std::atomic<Block*>& list = block->slot < MAX_THREAD_USED_BLOCK_SLOTS ? threadFreeBlocks[block->slot] : freeBlocks;
+            block->next = list.load();
+            list = block;
+          }
+          block = nextBlock;
+        }
       }
 
-      /* remove all shared blocks as they are re-added during build */
-      freeBlocks.store(Block::remove_shared_blocks(freeBlocks.load()));
-
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
         threadUsedBlocks[i] = nullptr;
@@ -474,6 +588,7 @@ namespace embree
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++) {
         threadUsedBlocks[i] = nullptr;
         threadBlocks[i] = nullptr;
+        threadFreeBlocks[i] = nullptr;
       }
       primrefarray.clear();
     }
@@ -504,6 +619,19 @@ namespace embree
         if (bytes > maxAllocationSize)
           throw_RTCError(RTC_ERROR_UNKNOWN,"allocation is too large");
 
+        /* lock-free reuse of blocks recycled from previous builds */
+        if (Block* block = pop_free_block(slot))
+        {
+          block->slot = slot;
+          push_block(threadBlocks[slot],block);
+
+          /* block stays unused until next reset if a different thread was faster or it is too small */
+          if (block->getBlockReservedBytes() >= bytes) {
+            threadUsedBlocks[slot].compare_exchange_strong(myUsedBlocks,block);
+            continue;
+          }
+        }
+
         /* parallel block creation in case of no freeBlocks, avoids single global mutex */
         if (likely(freeBlocks.load() == nullptr))
         {
@@ -512,7 +640,10 @@ namespace embree
             const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
             const size_t allocSize = max(min(growSize,maxGrowSize),alignedBytes);
             assert(allocSize >= bytes);
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype); // FIXME: a large allocation might throw away a block here!
+            Block* block = Block::create(device,allocSize,allocSize,nullptr,atype); // FIXME: a large allocation might throw away a block here!
+            block->slot = slot;
+            push_block(threadBlocks[slot],block);
+            threadUsedBlocks[slot] = block;
             // FIXME: a direct allocation should allocate inside the block here, and not in the next loop! a different thread could do some allocation and make the large allocation fail.
           }
           continue;
@@ -717,7 +848,7 @@ namespace embree
 
     struct Block
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      static Block* create(Device* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
       {
         /* We avoid using os_malloc for small blocks as this could
          * cause a risk of fragmenting the virtual address space and
@@ -752,6 +883,7 @@ namespace embree
             os_advise((void*)(ptr_aligned_begin +              0),PAGE_SIZE_2M); // may fail if no memory mapped before block
             os_advise((void*)(ptr_aligned_begin + 1*PAGE_SIZE_2M),PAGE_SIZE_2M);
             os_advise((void*)(ptr_aligned_begin + 2*PAGE_SIZE_2M),PAGE_SIZE_2M); // may fail if no memory mapped after block
+            os_interleave(ptr,bytesAllocate);
 
             return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
           }
@@ -760,13 +892,16 @@ namespace embree
             const size_t alignment = maxAlignment;
             if (device) device->memoryMonitor(bytesAllocate+alignment,false);
             ptr = alignedMalloc(bytesAllocate,alignment);
+            os_interleave(ptr,bytesAllocate);
             return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
           }
         }
         else if (atype == OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
-          bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
+          bool huge_pages;
+          if (useArena(device)) ptr = device->arena_pool->malloc(bytesReserve,huge_pages);
+          else                  ptr = os_malloc(bytesReserve,huge_pages);
           return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
         }
         else
@@ -776,7 +911,7 @@ namespace embree
       }
 
       Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), slot(-1), atype(atype), huge_pages(huge_pages)
       {
         assert((((size_t)&data[0]) & (maxAlignment-1)) == 0);
       }
@@ -791,7 +926,7 @@ namespace embree
         return head;
       }
 
-      void clear_list(MemoryMonitorInterface* device)
+      void clear_list(Device* device)
       {
         Block* block = this;
         while (block) {
@@ -801,7 +936,7 @@ namespace embree
         }
       }
 
-      void clear_block (MemoryMonitorInterface* device)
+      void clear_block (Device* device)
       {
         const size_t sizeof_Header = offsetof(Block,data[0]);
         const ssize_t sizeof_Alloced = wasted+sizeof_Header+getBlockAllocatedBytes();
@@ -813,7 +948,8 @@ namespace embree
 
         else if (atype == OS_MALLOC) {
          size_t sizeof_This = sizeof_Header+reserveEnd;
-         os_free(this,sizeof_This,huge_pages);
+         if (useArena(device)) device->arena_pool->free(this,sizeof_This,huge_pages);
+         else                  os_free(this,sizeof_This,huge_pages);
          if (device) device->memoryMonitor(-sizeof_Alloced,true);
         }
 
@@ -936,9 +1072,10 @@ namespace embree
       std::atomic<size_t> reserveEnd; //!< end of the reserved memory region
       Block* next;               //!< pointer to next block in list
       size_t wasted;             //!< amount of memory wasted through block alignment
+      size_t slot;               //!< thread slot that created or recycled this block, -1 for blocks of the global lists
       AllocationType atype;      //!< allocation mode of the block
       bool huge_pages;           //!< whether the block uses huge pages
-      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(bool)]; //!< align data to maxAlignment
+      char align[maxAlignment-6*sizeof(size_t)-sizeof(AllocationType)-sizeof(bool)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -951,6 +1088,7 @@ namespace embree
     std::atomic<Block*> freeBlocks;
 
     std::atomic<Block*> threadBlocks[MAX_THREAD_USED_BLOCK_SLOTS];
+    std::atomic<Block*> threadFreeBlocks[MAX_THREAD_USED_BLOCK_SLOTS]; //!< blocks recycled from previous builds per slot
     SpinLock slotMutex[MAX_THREAD_USED_BLOCK_SLOTS];
 
     bool use_single_mode;
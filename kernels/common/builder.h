@@ -37,6 +37,9 @@ namespace embree
 
     /*! clears internal builder state */
     virtual void clear() = 0;
+
+    /*! returns the predicted peak memory consumption of the next build in bytes, or 0 if unknown */
+    virtual size_t estimateMemory() { return 0; }
   };
 
   /*! virtual interface for progress monitor class */
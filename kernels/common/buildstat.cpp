@@ -0,0 +1,71 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "buildstat.h"
+
+namespace embree
+{
+  BuildStatistics::BuildStatistics ()
+    : t0(0.0), cpu0(0.0)
+  {
+    memset(&last,0,sizeof(last));
+    begin();
+  }
+
+  void BuildStatistics::begin()
+  {
+    for (size_t i=0; i<NUM_PHASES; i++)
+      nanoseconds[i].store(0);
+    for (size_t i=0; i<MAX_THREAD_SLOTS; i++)
+      for (size_t j=0; j<NUM_TASKS; j++)
+        slots[i].cycles[j].store(0);
+    t0 = getSeconds();
+    cpu0 = getCPUSeconds();
+  }
+
+  void BuildStatistics::end(size_t bytesAllocated, size_t bytesUsed)
+  {
+    const double dt = getSeconds()-t0;
+    const double dcpu = getCPUSeconds()-cpu0;
+    const size_t numThreads = TaskScheduler::threadCount();
+
+    RTCBuildStatistics stats;
+    memset(&stats,0,sizeof(stats));
+    stats.commitTime    = dt;
+    stats.primRefTime   = 1E-9*double(nanoseconds[PRIMREFS]);
+    stats.hierarchyTime = 1E-9*double(nanoseconds[HIERARCHY]);
+    stats.topLevelTime  = 1E-9*double(nanoseconds[TOPLEVEL]);
+    stats.refitTime     = 1E-9*double(nanoseconds[REFIT]);
+
+    /* divide the hierarchy construction time by the cycles spent in each task */
+    double cycles[NUM_TASKS] = { 0.0 };
+    for (size_t i=0; i<MAX_THREAD_SLOTS; i++)
+      for (size_t j=0; j<NUM_TASKS; j++)
+        cycles[j] += double(slots[i].cycles[j].load());
+    const double totalCycles = cycles[BINNING]+cycles[SPATIAL_SPLITS]+cycles[LEAVES];
+    if (totalCycles > 0.0) {
+      stats.binningTime      = stats.hierarchyTime*cycles[BINNING]/totalCycles;
+      stats.spatialSplitTime = stats.hierarchyTime*cycles[SPATIAL_SPLITS]/totalCycles;
+      stats.leafTime         = stats.hierarchyTime*cycles[LEAVES]/totalCycles;
+    }
+
+    stats.numThreads = (unsigned int) numThreads;
+    if (dt > 0.0) stats.threadUtilization = (float) min(1.0,dcpu/(dt*double(numThreads)));
+    stats.bytesAllocated = bytesAllocated;
+    stats.bytesUsed = bytesUsed;
+    last = stats;
+  }
+}
@@ -0,0 +1,130 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Gathers timings and memory consumption of scene commits. Phases
+   *  are timed with wall clock time and summed over all builds of a
+   *  commit. The hierarchy construction interleaves binning, spatial
+   *  splits and leaf creation on all build threads, thus its time gets
+   *  divided by the CPU cycles the threads spent in each of these
+   *  tasks. */
+  class BuildStatistics
+  {
+  public:
+
+    /*! build phases timed with wall clock time */
+    enum Phase { PRIMREFS, HIERARCHY, TOPLEVEL, REFIT, NUM_PHASES };
+
+    /*! tasks of the hierarchy construction timed with CPU cycles */
+    enum Task { BINNING, SPATIAL_SPLITS, LEAVES, NUM_TASKS };
+
+    /*! measures the wall clock time of a phase until stopped or destructed */
+    class PhaseTimer
+    {
+    public:
+      PhaseTimer (BuildStatistics* stats, Phase phase)
+        : stats(stats), phase(phase), t0(stats ? getSeconds() : 0.0) {}
+
+      ~PhaseTimer () {
+        stop();
+      }
+
+      void stop()
+      {
+        if (stats) stats->addTime(phase,getSeconds()-t0);
+        stats = nullptr;
+      }
+
+    private:
+      BuildStatistics* stats;
+      Phase phase;
+      double t0;
+    };
+
+    /*! measures the CPU cycles the calling thread spends in a task */
+    class TaskTimer
+    {
+    public:
+      __forceinline TaskTimer (BuildStatistics* stats, Task task)
+        : stats(stats), task(task), c0(stats ? read_tsc() : 0) {}
+
+      __forceinline ~TaskTimer () {
+        stop();
+      }
+
+      __forceinline void start() {
+        if (stats) c0 = read_tsc();
+      }
+
+      __forceinline void stop()
+      {
+        if (stats && c0) {
+          stats->addCycles(task,read_tsc()-c0);
+          c0 = 0;
+        }
+      }
+
+    private:
+      BuildStatistics* stats;
+      Task task;
+      size_t c0;
+    };
+
+  public:
+
+    BuildStatistics ();
+
+    /*! starts gathering the statistics of a commit */
+    void begin();
+
+    /*! finishes the statistics of a commit */
+    void end(size_t bytesAllocated, size_t bytesUsed);
+
+    /*! adds wall clock time to some phase */
+    __forceinline void addTime(Phase phase, double dt) {
+      nanoseconds[phase] += int64_t(1E9*dt);
+    }
+
+    /*! adds CPU cycles of the calling thread to some task */
+    __forceinline void addCycles(Task task, size_t dc) {
+      slots[TaskScheduler::threadIndex() & (MAX_THREAD_SLOTS-1)].cycles[task].fetch_add(dc,std::memory_order_relaxed);
+    }
+
+    /*! returns the statistics of the last finished commit */
+    const RTCBuildStatistics& get() const {
+      return last;
+    }
+
+  private:
+    static const size_t MAX_THREAD_SLOTS = 64;
+
+    /*! per thread cycle counters, padded to avoid false sharing */
+    struct __aligned(64) ThreadSlot {
+      std::atomic<size_t> cycles[NUM_TASKS];
+    };
+
+    std::atomic<int64_t> nanoseconds[NUM_PHASES];
+    ThreadSlot slots[MAX_THREAD_SLOTS];
+    double t0;                //!< wall clock time at begin of commit
+    double cpu0;              //!< process CPU time at begin of commit
+    RTCBuildStatistics last;  //!< statistics of last finished commit
+  };
+}
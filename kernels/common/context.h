@@ -18,19 +18,63 @@
 
 #include "default.h"
 #include "rtcore.h"
+#include "instance_stack.h"
 
 namespace embree
 {
   class Scene;
 
+  /*! Collects the nearest hits of a ray sorted by distance into a user provided buffer. */
+  struct HitCollector
+  {
+  public:
+    __forceinline HitCollector () {}
+
+    __forceinline HitCollector (RTCHitRecord* hits, unsigned int maxHits, float tfar)
+      : hits(hits), maxHits(maxHits), numHits(0), tfar(tfar) {}
+
+    /*! inserts hit i of a hit packet of size N found at distance t */
+    __forceinline void insert(float t, RTCHitN* hit, unsigned int N, unsigned int i)
+    {
+      const unsigned int primID = RTCHitN_primID(hit,N,i);
+      const unsigned int geomID = RTCHitN_geomID(hit,N,i);
+      if (numHits == maxHits && t >= tfar) return;
+
+      /* primitives referenced multiple times report identical hits */
+      for (unsigned int j=0; j<numHits; j++) {
+        if (hits[j].t != t || hits[j].hit.primID != primID || hits[j].hit.geomID != geomID) continue;
+        bool sameInstance = true;
+        for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          sameInstance &= hits[j].hit.instID[l] == RTCHitN_instID(hit,N,i,l);
+        if (sameInstance) return;
+      }
+
+      /* insertion sort into the hit buffer, dropping the farthest hit if it is full */
+      unsigned int j = numHits < maxHits ? numHits++ : maxHits-1;
+      for (; j>0 && hits[j-1].t > t; j--)
+        hits[j] = hits[j-1];
+      hits[j].t = t;
+      hits[j].hit = rtcGetHitFromHitN(hit,N,i);
+
+      /* once the buffer is full only hits closer than the farthest collected hit are of interest */
+      if (numHits == maxHits) tfar = hits[maxHits-1].t;
+    }
+
+  public:
+    RTCHitRecord* hits;     //!< hit buffer sorted by distance
+    unsigned int maxHits;   //!< capacity of the hit buffer
+    unsigned int numHits;   //!< number of collected hits
+    float tfar;             //!< far distance for further traversal
+  };
+
   struct IntersectContext
   {
   public:
-    __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context)
-      : scene(scene), user(user_context), instID(user_context->instID[0]) {}
+    __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context, HitCollector* collector = nullptr)
+      : scene(scene), user(user_context), collector(collector) {}
 
     __forceinline bool hasContextFilter() const {
-      return user->filter != nullptr;
+      return user->filter != nullptr || collector != nullptr;
     }
 
     __forceinline bool isCoherent() const {
@@ -40,10 +84,26 @@ namespace embree
     __forceinline bool isIncoherent() const {
       return embree::isIncoherent(user->flags);
     }
+
+    __forceinline bool isSortRays() const {
+      return embree::isSortRays(user->flags);
+    }
     
   public:
     Scene* scene;
     RTCIntersectContext* user;
-    unsigned int instID;
+    HitCollector* collector; //!< per ray hit collectors of multi-hit queries, or nullptr
+  };
+
+  struct PointQueryContext
+  {
+  public:
+    __forceinline PointQueryContext(Scene* scene, RTCPointQueryFunction func, void* userPtr)
+      : scene(scene), func(func), userPtr(userPtr) {}
+
+  public:
+    Scene* scene;
+    RTCPointQueryFunction func;
+    void* userPtr;
   };
 }
@@ -26,6 +26,7 @@
 
 #include "acceln.h"
 #include "geometry.h"
+#include "alloc.h"
 
 #include "../geometry/cylinder.h"
 
@@ -72,7 +73,23 @@ namespace embree
       State::hugepages_success &= win_enable_selockmemoryprivilege(State::verbosity(3));
 #endif
     State::hugepages_success &= os_init(State::hugepages,State::verbosity(3));
+
+    /*! NUMA mode pins threads node by node and optionally interleaves memory */
+    State::numa_success &= os_init_numa(State::numa >= 2,State::verbosity(3));
+    setNumaThreadMapping(State::numa >= 1);
+    if (State::numa >= 1) State::set_affinity = true;
+
+    /*! out-of-core mode backs OS allocated memory by files */
+    State::out_of_core_success &= os_init_file_backing(State::out_of_core_directory,State::verbosity(3));
     
+    /*! pool of pre-faulted memory blocks reused across builds */
+    if (State::alloc_arena_size)
+      arena_pool = make_unique(new ArenaPool(State::alloc_arena_size));
+
+    /*! traversal counters can also get enabled through a device property */
+    if (State::traversal_statistics)
+      TravStat::setEnabled(true);
+
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
@@ -370,9 +387,54 @@ namespace embree
     case 1000003: debug_int3 = val; return;
     }
 
+    /* documented properties */
+    switch (prop) 
+    {
+    case RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_ENABLED: TravStat::setEnabled(val != 0); return;
+    default: break;
+    }
+
     throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown writable property");
   }
 
+  void Device::getTraversalStatistics(RTCTraversalStatistics* stats)
+  {
+    static_assert(Geometry::GTY_END <= TravStat::MAX_GEOMETRY_TYPES, "too many geometry types for traversal statistics");
+    TravStat::Counters cntrs;
+    TravStat::sum(cntrs);
+
+    memset(stats,0,sizeof(RTCTraversalStatistics));
+    stats->intersectRays  = cntrs.normal.travs;
+    stats->occludedRays   = cntrs.shadow.travs;
+    stats->nodeVisits     = cntrs.normal.trav_nodes  + cntrs.shadow.trav_nodes;
+    stats->leafVisits     = cntrs.normal.trav_leaves + cntrs.shadow.trav_leaves;
+    stats->primitiveTests = cntrs.normal.trav_prims  + cntrs.shadow.trav_prims;
+    stats->filterCalls    = cntrs.filter_calls;
+    stats->instanceHits   = cntrs.instance_hits;
+
+    /* group the hits by the public geometry type */
+    for (size_t gtype=0; gtype<Geometry::GTY_END; gtype++)
+    {
+      const size_t hits = cntrs.hits[gtype];
+      switch (gtype) {
+      case Geometry::GTY_TRIANGLE_MESH  : stats->triangleHits    += hits; break;
+      case Geometry::GTY_QUAD_MESH      : stats->quadHits        += hits; break;
+      case Geometry::GTY_GRID_MESH      : stats->gridHits        += hits; break;
+      case Geometry::GTY_SUBDIV_MESH    : stats->subdivisionHits += hits; break;
+      case Geometry::GTY_USER_GEOMETRY  : stats->userHits        += hits; break;
+      case Geometry::GTY_INSTANCE       : break;
+      case Geometry::GTY_SPHERE_POINT   :
+      case Geometry::GTY_DISC_POINT     :
+      case Geometry::GTY_ORIENTED_DISC_POINT: stats->pointHits   += hits; break;
+      default                           : stats->curveHits       += hits; break;
+      }
+    }
+  }
+
+  void Device::resetTraversalStatistics() {
+    TravStat::clear();
+  }
+
   ssize_t Device::getProperty(const RTCDeviceProperty prop)
   {
     size_t iprop = (size_t)prop;
@@ -449,6 +511,8 @@ namespace embree
     case RTC_DEVICE_PROPERTY_IGNORE_INVALID_RAYS_ENABLED: return 0;
 #endif
 
+    case RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_ENABLED: return TravStat::isEnabled();
+
 #if defined(TASKING_INTERNAL)
     case RTC_DEVICE_PROPERTY_TASKING_SYSTEM: return 0;
 #endif
@@ -24,6 +24,7 @@ namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  class ArenaPool;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -67,6 +68,12 @@ namespace embree
     /*! gets a property */
     ssize_t getProperty(const RTCDeviceProperty prop);
 
+    /*! returns the traversal counters of all threads */
+    void getTraversalStatistics(RTCTraversalStatistics* stats);
+
+    /*! resets the traversal counters of all threads */
+    void resetTraversalStatistics();
+
   private:
 
     /*! initializes the tasking system */
@@ -91,6 +98,9 @@ namespace embree
 #if USE_TASK_ARENA
     std::unique_ptr<tbb::task_arena> arena;
 #endif
+
+    /* pre-faulted allocator blocks shared by all scenes, only used if alloc_arena_size is set */
+    std::unique_ptr<ArenaPool> arena_pool;
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
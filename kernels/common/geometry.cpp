@@ -43,6 +43,9 @@ namespace embree
     "subdivs",
     "usergeom",
     "instance",
+    "sphere_point",
+    "disc_point",
+    "oriented_disc_point",
   };
      
   Geometry::Geometry (Device* device, GType gtype, unsigned int numPrimitives, unsigned int numTimeSteps) 
@@ -54,7 +57,7 @@ namespace embree
       state(MODIFIED),
       numPrimitivesChanged(false),
       enabled(true),
-      intersectionFilterN(nullptr), occlusionFilterN(nullptr)
+      intersectionFilterN(nullptr), occlusionFilterN(nullptr), pointQueryFunc(nullptr)
   {
     device->refInc();
   }
@@ -190,7 +193,7 @@ namespace embree
   
   void Geometry::setIntersectionFilterFunctionN (RTCFilterFunctionN filter) 
   {
-    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_SUBDIV_MESH | MTY_USER_GEOMETRY | MTY_GRID_MESH)))
+    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_POINTS | MTY_SUBDIV_MESH | MTY_USER_GEOMETRY | MTY_GRID_MESH)))
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"filter functions not supported for this geometry"); 
 
     if (scene && isEnabled()) {
@@ -202,7 +205,7 @@ namespace embree
 
   void Geometry::setOcclusionFilterFunctionN (RTCFilterFunctionN filter) 
   {
-    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_SUBDIV_MESH | MTY_USER_GEOMETRY | MTY_GRID_MESH)))
+    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_POINTS | MTY_SUBDIV_MESH | MTY_USER_GEOMETRY | MTY_GRID_MESH)))
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"filter functions not supported for this geometry"); 
 
     if (scene && isEnabled()) {
@@ -212,6 +215,11 @@ namespace embree
     occlusionFilterN = filter;
   }
 
+  void Geometry::setPointQueryFunction (RTCPointQueryFunction func) 
+  {
+    pointQueryFunc = func;
+  }
+
   void Geometry::interpolateN(const RTCInterpolateNArguments* const args)
   {
     const void* valid_i = args->valid;
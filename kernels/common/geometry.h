@@ -83,7 +83,11 @@ namespace embree
       
       GTY_USER_GEOMETRY = 20,
       GTY_INSTANCE = 21,
-      GTY_END = 22,
+
+      GTY_SPHERE_POINT = 22,
+      GTY_DISC_POINT = 23,
+      GTY_ORIENTED_DISC_POINT = 24,
+      GTY_END = 25,
 
       GTY_BASIS_LINEAR = 0,
       GTY_BASIS_BEZIER = 4,
@@ -129,6 +133,12 @@ namespace embree
       MTY_SUBDIV_MESH = 1 << GTY_SUBDIV_MESH,
       MTY_USER_GEOMETRY = 1 << GTY_USER_GEOMETRY,
       MTY_INSTANCE = 1 << GTY_INSTANCE,
+
+      MTY_SPHERE_POINT = 1 << GTY_SPHERE_POINT,
+      MTY_DISC_POINT = 1 << GTY_DISC_POINT,
+      MTY_ORIENTED_DISC_POINT = 1 << GTY_ORIENTED_DISC_POINT,
+
+      MTY_POINTS = MTY_SPHERE_POINT | MTY_DISC_POINT | MTY_ORIENTED_DISC_POINT,
     };
 
     static const char* gtype_names[GTY_END];
@@ -318,6 +328,9 @@ namespace embree
     /*! Set occlusion filter function for ray packets of size N. */
     virtual void setOcclusionFilterFunctionN (RTCFilterFunctionN filterN);
 
+    /*! Set point query function. */
+    void setPointQueryFunction (RTCPointQueryFunction func);
+
     /*! for instances only */
   public:
 
@@ -439,5 +452,6 @@ namespace embree
   public:
     RTCFilterFunctionN intersectionFilterN;
     RTCFilterFunctionN occlusionFilterN;
+    RTCPointQueryFunction pointQueryFunc;
   };
 }
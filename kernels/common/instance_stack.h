@@ -0,0 +1,79 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "rtcore.h"
+
+namespace embree
+{
+  /*! The instance ID stack of the intersection context stores the
+   *  geometry IDs of all instances entered along the path to the
+   *  current scene. The stack is terminated by the first
+   *  RTC_INVALID_GEOMETRY_ID entry, thus unused levels have to stay
+   *  invalid. */
+  namespace instance_id_stack
+  {
+    /*! pushes an instance ID, returns false if the maximal number of instance levels is reached */
+    __forceinline bool push(RTCIntersectContext* context, unsigned int instID)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      {
+        if (context->instID[l] == RTC_INVALID_GEOMETRY_ID) {
+          context->instID[l] = instID;
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /*! pops the top most instance ID */
+    __forceinline void pop(RTCIntersectContext* context)
+    {
+      for (unsigned int l = RTC_MAX_INSTANCE_LEVEL_COUNT; l > 0; l--)
+      {
+        if (context->instID[l-1] != RTC_INVALID_GEOMETRY_ID) {
+          context->instID[l-1] = RTC_INVALID_GEOMETRY_ID;
+          return;
+        }
+      }
+    }
+
+    /*! copies the instance ID stack into a single hit */
+    __forceinline void copy(const unsigned int* src, unsigned int* dst)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        dst[l] = src[l];
+    }
+
+    /*! copies the instance ID stack into lane k of a hit packet */
+    template<int K>
+    __forceinline void copy(const unsigned int* src, vuint<K>* dst, size_t k)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        dst[l][k] = src[l];
+    }
+
+    /*! copies the instance ID stack into all valid lanes of a hit packet */
+    template<int K>
+    __forceinline void copy(const vbool<K>& valid, const unsigned int* src, vuint<K>* dst)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        vuint<K>::store(valid, &dst[l], vuint<K>(src[l]));
+    }
+  }
+}
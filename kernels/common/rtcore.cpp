@@ -24,6 +24,7 @@
 #include "device.h"
 #include "scene.h"
 #include "context.h"
+#include "scene_instance.h"
 #include "../../include/embree3/rtcore_ray.h"
 
 namespace embree
@@ -31,6 +32,105 @@ namespace embree
   /* mutex to make API thread safe */
   static MutexSys g_mutex;
 
+  /*! counts the active rays of a ray packet */
+  template<int N>
+  static __forceinline size_t numActiveRays(const int* valid)
+  {
+    size_t cnt = 0;
+    for (size_t i=0; i<N; i++) cnt += valid[i] == -1;
+    return cnt;
+  }
+
+  /*! records the closest hits of N rays in the traversal statistics,
+   *  geomID(i) returns the geometry ID of the i'th ray and instID(i,l)
+   *  its instance ID at instance level l */
+  template<typename GeomIDFunc, typename InstIDFunc>
+  static void recordHits(Scene* scene, size_t N, const GeomIDFunc& geomID, const InstIDFunc& instID)
+  {
+    if (likely(!TravStat::isEnabled())) return;
+    
+    TravStat::Counters& counters = TravStat::get();
+    for (size_t i=0; i<N; i++)
+    {
+      const unsigned int geomID_i = geomID(i);
+      if (geomID_i == RTC_INVALID_GEOMETRY_ID) continue;
+
+      /* walk down the instance stack to the scene containing the hit geometry */
+      Scene* hit_scene = scene;
+      for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      {
+        const unsigned int instID_l = instID(i,l);
+        if (instID_l == RTC_INVALID_GEOMETRY_ID) break;
+        Instance* instance = (Instance*) hit_scene->get(instID_l);
+        hit_scene = (Scene*) instance->object;
+        if (l == 0) counters.instance_hits++;
+      }
+
+      const Geometry* geometry = hit_scene->get(geomID_i);
+      if (geometry) counters.hits[geometry->getType()]++;
+    }
+  }
+
+  /*! records the closest hits of a ray packet of size N */
+  template<size_t N, typename RTCRayHitK>
+  static __forceinline void recordHits(Scene* scene, const int* valid, const RTCRayHitK* rayhit)
+  {
+    recordHits(scene,N,
+               [&] (size_t i) { return valid[i] == -1 ? rayhit->hit.geomID[i] : RTC_INVALID_GEOMETRY_ID; },
+               [&] (size_t i, unsigned int l) { return rayhit->hit.instID[l][i]; });
+  }
+
+  /*! records the closest hits of a stream of M single rays */
+  static __forceinline void recordHits(Scene* scene, const RTCRayHit* rayhit, size_t M, size_t byteStride)
+  {
+    auto get = [&] (size_t i) -> const RTCRayHit& { return *(const RTCRayHit*)((const char*)rayhit + i*byteStride); };
+    recordHits(scene,M,
+               [&] (size_t i) { return get(i).hit.geomID; },
+               [&] (size_t i, unsigned int l) { return get(i).hit.instID[l]; });
+  }
+
+  /*! intersects a packet of K rays and collects up to maxHits hits per ray into
+   *  hits[i*maxHits], the closest collected hit of each ray is stored in rayhit */
+  template<int K, typename RTCRayHitK, typename IntersectPacketFunc>
+  static void intersectHits(const int* valid, Scene* scene, RTCIntersectContext* user_context, RTCRayHitK* rayhit, RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits,
+                            bool packets, const IntersectPacketFunc& intersectPacket)
+  {
+    if (maxHits == 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"maxHits has to be larger than zero");
+    RTCRayHitN* rayhitN = (RTCRayHitN*) rayhit;
+    RTCRayN* rayN = RTCRayHitN_RayN(rayhitN,K);
+    RTCHitN* hitN = RTCRayHitN_HitN(rayhitN,K);
+
+    HitCollector collectors[K];
+    for (unsigned int i=0; i<K; i++)
+      collectors[i] = HitCollector(hits+i*maxHits,maxHits,RTCRayN_tfar(rayN,K,i));
+
+#if defined(EMBREE_RAY_PACKETS)
+    if (likely(packets))
+    {
+      IntersectContext context(scene,user_context,collectors);
+      intersectPacket(&context);
+    }
+    else
+#endif
+    {
+      for (unsigned int i=0; i<K; i++)
+      {
+        if (!valid[i]) continue;
+        RTCRayHit ray1 = rtcGetRayHitFromRayHitN(rayhitN,K,i);
+        IntersectContext context(scene,user_context,&collectors[i]);
+        scene->localIntersectors().intersect(ray1,&context);
+      }
+    }
+
+    for (unsigned int i=0; i<K; i++)
+    {
+      numHits[i] = valid[i] ? collectors[i].numHits : 0;
+      if (numHits[i] == 0) continue;
+      RTCRayN_tfar(rayN,K,i) = hits[i*maxHits].t;
+      rtcCopyHitToHitN(hitN,&hits[i*maxHits].hit,K,i);
+    }
+  }
+
   RTC_API RTCDevice rtcNewDevice(const char* config)
   {
     RTC_CATCH_BEGIN;
@@ -118,6 +218,27 @@ namespace embree
     RTC_CATCH_END(device);
   }
 
+  RTC_API void rtcGetDeviceTraversalStatistics(RTCDevice hdevice, RTCTraversalStatistics* stats)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetDeviceTraversalStatistics);
+    RTC_VERIFY_HANDLE(hdevice);
+    RTC_VERIFY_HANDLE(stats);
+    device->getTraversalStatistics(stats);
+    RTC_CATCH_END(device);
+  }
+
+  RTC_API void rtcResetDeviceTraversalStatistics(RTCDevice hdevice)
+  {
+    Device* device = (Device*) hdevice;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetDeviceTraversalStatistics);
+    RTC_VERIFY_HANDLE(hdevice);
+    device->resetTraversalStatistics();
+    RTC_CATCH_END(device);
+  }
+
   RTC_API RTCBuffer rtcNewBuffer(RTCDevice hdevice, size_t byteSize)
   {
     RTC_CATCH_BEGIN;
@@ -248,6 +369,117 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API RTCCommitFuture rtcCommitSceneAsync (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitSceneAsync);
+    RTC_VERIFY_HANDLE(hscene);
+    CommitFuture* future = new CommitFuture(scene);
+    return (RTCCommitFuture) future->refInc();
+    RTC_CATCH_END2(scene);
+    return nullptr;
+  }
+
+  RTC_API bool rtcIsCommitFutureReady (RTCCommitFuture hfuture) 
+  {
+    CommitFuture* future = (CommitFuture*) hfuture;
+    Scene* scene = future ? future->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIsCommitFutureReady);
+    RTC_VERIFY_HANDLE(hfuture);
+    return future->isReady();
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
+  RTC_API void rtcWaitCommitFuture (RTCCommitFuture hfuture) 
+  {
+    CommitFuture* future = (CommitFuture*) hfuture;
+    Scene* scene = future ? future->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcWaitCommitFuture);
+    RTC_VERIFY_HANDLE(hfuture);
+    future->wait();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcRetainCommitFuture (RTCCommitFuture hfuture) 
+  {
+    CommitFuture* future = (CommitFuture*) hfuture;
+    Scene* scene = future ? future->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcRetainCommitFuture);
+    RTC_VERIFY_HANDLE(hfuture);
+    future->refInc();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcReleaseCommitFuture (RTCCommitFuture hfuture) 
+  {
+    CommitFuture* future = (CommitFuture*) hfuture;
+    Scene* scene = future ? future->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcReleaseCommitFuture);
+    RTC_VERIFY_HANDLE(hfuture);
+    future->refDec();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSaveSceneBVH (RTCScene hscene, const char* filename) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSaveSceneBVH);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->saveBVH(filename);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcLoadSceneBVH (RTCScene hscene, const char* filename) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcLoadSceneBVH);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->loadBVH(filename);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API size_t rtcGetSceneBuildMemoryEstimate (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBuildMemoryEstimate);
+    RTC_VERIFY_HANDLE(hscene);
+    return scene->estimateBuildMemory();
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcSetSceneBuildMemoryBudget (RTCScene hscene, size_t bytes) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildMemoryBudget);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->setBuildMemoryBudget(bytes);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetSceneBuildStatistics (RTCScene hscene, RTCBuildStatistics* stats) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBuildStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(stats);
+    *stats = scene->getBuildStatistics();
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -309,10 +541,11 @@ namespace embree
 #endif
     STAT3(normal.travs,1,1,1);
     IntersectContext context(scene,user_context);
-    scene->intersectors.intersect(*rayhit,&context);
+    scene->localIntersectors().intersect(*rayhit,&context);
 #if defined(DEBUG)
     ((RayHit*)rayhit)->verifyHit();
 #endif
+    recordHits(scene,(RTCRayHit*)rayhit,1,sizeof(RTCRayHit));
     RTC_CATCH_END2(scene);
   }
 
@@ -328,8 +561,7 @@ namespace embree
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)rayhit)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
 #endif
-    STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT3(normal.travs,numActiveRays<4>(valid),numActiveRays<4>(valid),numActiveRays<4>(valid));
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -337,13 +569,14 @@ namespace embree
     for (size_t i=0; i<4; i++) {
       if (!valid[i]) continue;
       RayHit ray1; ray4->get(i,ray1);
-      scene->intersectors.intersect((RTCRayHit&)ray1,&context);
+      scene->localIntersectors().intersect((RTCRayHit&)ray1,&context);
       ray4->set(i,ray1);
     }
 #else
-    scene->intersectors.intersect4(valid,*rayhit,&context);
+    scene->localIntersectors().intersect4(valid,*rayhit,&context);
 #endif
     
+    recordHits<4>(scene,valid,rayhit);
     RTC_CATCH_END2(scene);
   }
   
@@ -359,8 +592,7 @@ namespace embree
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)rayhit)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 32 bytes");   
 #endif
-    STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT3(normal.travs,numActiveRays<8>(valid),numActiveRays<8>(valid),numActiveRays<8>(valid));
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -368,15 +600,16 @@ namespace embree
     for (size_t i=0; i<8; i++) {
       if (!valid[i]) continue;
       RayHit ray1; ray8->get(i,ray1);
-      scene->intersectors.intersect((RTCRayHit&)ray1,&context);
+      scene->localIntersectors().intersect((RTCRayHit&)ray1,&context);
       ray8->set(i,ray1);
     }
 #else
-    if (likely(scene->intersectors.intersector8))
-      scene->intersectors.intersect8(valid,*rayhit,&context);
+    if (likely(scene->localIntersectors().intersector8))
+      scene->localIntersectors().intersect8(valid,*rayhit,&context);
     else
       scene->device->rayStreamFilters.intersectSOA(scene,(char*)rayhit,8,1,sizeof(RTCRayHit8),&context);
 #endif
+    recordHits<8>(scene,valid,rayhit);
     RTC_CATCH_END2(scene);
   }
   
@@ -392,8 +625,7 @@ namespace embree
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)rayhit)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");   
 #endif
-    STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(normal.travs,cnt,cnt,cnt);
+    STAT3(normal.travs,numActiveRays<16>(valid),numActiveRays<16>(valid),numActiveRays<16>(valid));
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -401,14 +633,110 @@ namespace embree
     for (size_t i=0; i<16; i++) {
       if (!valid[i]) continue;
       RayHit ray1; ray16->get(i,ray1);
-      scene->intersectors.intersect((RTCRayHit&)ray1,&context);
+      scene->localIntersectors().intersect((RTCRayHit&)ray1,&context);
       ray16->set(i,ray1);
     }
 #else
-    if (likely(scene->intersectors.intersector16))
-      scene->intersectors.intersect16(valid,*rayhit,&context);
+    if (likely(scene->localIntersectors().intersector16))
+      scene->localIntersectors().intersect16(valid,*rayhit,&context);
     else
       scene->device->rayStreamFilters.intersectSOA(scene,(char*)rayhit,16,1,sizeof(RTCRayHit16),&context);
+#endif
+    recordHits<16>(scene,valid,rayhit);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API unsigned int rtcIntersect1Hits (RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit* rayhit, RTCHitRecord* hits, unsigned int maxHits) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect1Hits);
+#if defined(EMBREE_FILTER_FUNCTION)
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
+#endif
+    if (maxHits == 0) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"maxHits has to be larger than zero");
+    STAT3(normal.travs,1,1,1);
+    HitCollector collector(hits,maxHits,rayhit->ray.tfar);
+    IntersectContext context(scene,user_context,&collector);
+    scene->localIntersectors().intersect(*rayhit,&context);
+    if (collector.numHits) {
+      rayhit->ray.tfar = hits[0].t;
+      rayhit->hit = hits[0].hit;
+    }
+    recordHits(scene,(RTCRayHit*)rayhit,1,sizeof(RTCRayHit));
+    return collector.numHits;
+#else
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect1Hits not supported");
+#endif
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcIntersect4Hits (const int* valid, RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit4* rayhit, RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect4Hits);
+#if defined(EMBREE_FILTER_FUNCTION)
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)rayhit)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
+#endif
+    STAT3(normal.travs,numActiveRays<4>(valid),numActiveRays<4>(valid),numActiveRays<4>(valid));
+    intersectHits<4>(valid,scene,user_context,rayhit,hits,numHits,maxHits,true,
+                     [&] (IntersectContext* context) { scene->localIntersectors().intersect4(valid,*rayhit,context); });
+    recordHits<4>(scene,valid,rayhit);
+#else
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect4Hits not supported");
+#endif
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersect8Hits (const int* valid, RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit8* rayhit, RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect8Hits);
+#if defined(EMBREE_FILTER_FUNCTION)
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
+    if (((size_t)rayhit)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 32 bytes");   
+#endif
+    STAT3(normal.travs,numActiveRays<8>(valid),numActiveRays<8>(valid),numActiveRays<8>(valid));
+    intersectHits<8>(valid,scene,user_context,rayhit,hits,numHits,maxHits,scene->localIntersectors().intersector8,
+                     [&] (IntersectContext* context) { scene->localIntersectors().intersect8(valid,*rayhit,context); });
+    recordHits<8>(scene,valid,rayhit);
+#else
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect8Hits not supported");
+#endif
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcIntersect16Hits (const int* valid, RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit16* rayhit, RTCHitRecord* hits, unsigned int* numHits, unsigned int maxHits) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcIntersect16Hits);
+#if defined(EMBREE_FILTER_FUNCTION)
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
+    if (((size_t)rayhit)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");   
+#endif
+    STAT3(normal.travs,numActiveRays<16>(valid),numActiveRays<16>(valid),numActiveRays<16>(valid));
+    intersectHits<16>(valid,scene,user_context,rayhit,hits,numHits,maxHits,scene->localIntersectors().intersector16,
+                      [&] (IntersectContext* context) { scene->localIntersectors().intersect16(valid,*rayhit,context); });
+    recordHits<16>(scene,valid,rayhit);
+#else
+    throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect16Hits not supported");
 #endif
     RTC_CATCH_END2(scene);
   }
@@ -431,13 +759,14 @@ namespace embree
     /* fast codepath for single rays */
     if (likely(M == 1)) {
       if (likely(rayhit->ray.tnear <= rayhit->ray.tfar)) 
-        scene->intersectors.intersect(*rayhit,&context);
+        scene->localIntersectors().intersect(*rayhit,&context);
     } 
 
     /* codepath for streams */
     else {
       scene->device->rayStreamFilters.intersectAOS(scene,rayhit,M,byteStride,&context);   
     }
+    recordHits(scene,rayhit,M,byteStride);
 #else
     throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect1M not supported");
 #endif
@@ -462,13 +791,16 @@ namespace embree
     /* fast codepath for single rays */
     if (likely(M == 1)) {
       if (likely(rn[0]->ray.tnear <= rn[0]->ray.tfar)) 
-        scene->intersectors.intersect(*rn[0],&context);
+        scene->localIntersectors().intersect(*rn[0],&context);
     } 
 
     /* codepath for streams */
     else {
       scene->device->rayStreamFilters.intersectAOP(scene,rn,M,&context);
     }
+    recordHits(scene,M,
+               [&] (size_t i) { return rn[i]->hit.geomID; },
+               [&] (size_t i, unsigned int l) { return rn[i]->hit.instID[l]; });
 #else
     throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect1Mp not supported");
 #endif
@@ -496,7 +828,7 @@ namespace embree
       /* fast code path for streams of size 1 */
       if (likely(M == 1)) {
         if (likely(((RTCRayHit*)rayhit)->ray.tnear <= ((RTCRayHit*)rayhit)->ray.tfar))
-          scene->intersectors.intersect(*(RTCRayHit*)rayhit,&context);
+          scene->localIntersectors().intersect(*(RTCRayHit*)rayhit,&context);
       } 
       /* normal codepath for single ray streams */
       else {
@@ -507,6 +839,10 @@ namespace embree
     else {
       scene->device->rayStreamFilters.intersectSOA(scene,(char*)rayhit,N,M,byteStride,&context);
     }
+    auto hitN = [&] (size_t i) { return RTCRayHitN_HitN((RTCRayHitN*)((char*)rayhit+(i/N)*byteStride),N); };
+    recordHits(scene,size_t(N)*M,
+               [&] (size_t i) { return RTCHitN_geomID(hitN(i),N,i%N); },
+               [&] (size_t i, unsigned int l) { return RTCHitN_instID(hitN(i),N,i%N,l); });
 #else
     throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersectNM not supported");
 #endif
@@ -540,11 +876,15 @@ namespace embree
     if (((size_t)rayhit->hit.v     ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.v not aligned to 4 bytes");   
     if (((size_t)rayhit->hit.geomID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.geomID not aligned to 4 bytes");   
     if (((size_t)rayhit->hit.primID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.primID not aligned to 4 bytes");   
-    if (((size_t)rayhit->hit.instID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.instID not aligned to 4 bytes");   
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      if (((size_t)rayhit->hit.instID[l]) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.instID not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N,N,N);
     IntersectContext context(scene,user_context);
     scene->device->rayStreamFilters.intersectSOP(scene,rayhit,N,&context);
+    recordHits(scene,N,
+               [&] (size_t i) { return rayhit->hit.geomID[i]; },
+               [&] (size_t i, unsigned int l) { return rayhit->hit.instID[l][i]; });
 #else
     throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersectNp not supported");
 #endif
@@ -563,7 +903,7 @@ namespace embree
     if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     IntersectContext context(scene,user_context);
-    scene->intersectors.occluded(*ray,&context);
+    scene->localIntersectors().occluded(*ray,&context);
     RTC_CATCH_END2(scene);
   }
   
@@ -579,8 +919,7 @@ namespace embree
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)ray)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
-    STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(shadow.travs,cnt,cnt,cnt);
+    STAT3(shadow.travs,numActiveRays<4>(valid),numActiveRays<4>(valid),numActiveRays<4>(valid));
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -588,11 +927,11 @@ namespace embree
     for (size_t i=0; i<4; i++) {
       if (!valid[i]) continue;
       RayHit ray1; ray4->get(i,ray1);
-      scene->intersectors.occluded((RTCRay&)ray1,&context);
+      scene->localIntersectors().occluded((RTCRay&)ray1,&context);
       ray4->geomID[i] = ray1.geomID; 
     }
 #else
-    scene->intersectors.occluded4(valid,*ray,&context);
+    scene->localIntersectors().occluded4(valid,*ray,&context);
 #endif
     
     RTC_CATCH_END2(scene);
@@ -610,8 +949,7 @@ namespace embree
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)ray)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
-    STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(shadow.travs,cnt,cnt,cnt);
+    STAT3(shadow.travs,numActiveRays<8>(valid),numActiveRays<8>(valid),numActiveRays<8>(valid));
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -619,12 +957,12 @@ namespace embree
     for (size_t i=0; i<8; i++) {
       if (!valid[i]) continue;
       RayHit ray1; ray8->get(i,ray1);
-      scene->intersectors.occluded((RTCRay&)ray1,&context);
+      scene->localIntersectors().occluded((RTCRay&)ray1,&context);
       ray8->set(i,ray1);
     }
 #else
-    if (likely(scene->intersectors.intersector8))
-      scene->intersectors.occluded8(valid,*ray,&context);
+    if (likely(scene->localIntersectors().intersector8))
+      scene->localIntersectors().occluded8(valid,*ray,&context);
     else
       scene->device->rayStreamFilters.occludedSOA(scene,(char*)ray,8,1,sizeof(RTCRay8),&context);
 #endif
@@ -644,8 +982,7 @@ namespace embree
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)ray)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
-    STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
-    STAT3(shadow.travs,cnt,cnt,cnt);
+    STAT3(shadow.travs,numActiveRays<16>(valid),numActiveRays<16>(valid),numActiveRays<16>(valid));
 
     IntersectContext context(scene,user_context);
 #if !defined(EMBREE_RAY_PACKETS)
@@ -653,12 +990,12 @@ namespace embree
     for (size_t i=0; i<16; i++) {
       if (!valid[i]) continue;
       RayHit ray1; ray16->get(i,ray1);
-      scene->intersectors.occluded((RTCRay&)ray1,&context);
+      scene->localIntersectors().occluded((RTCRay&)ray1,&context);
       ray16->set(i,ray1);
     }
 #else
-    if (likely(scene->intersectors.intersector16))
-      scene->intersectors.occluded16(valid,*ray,&context);
+    if (likely(scene->localIntersectors().intersector16))
+      scene->localIntersectors().occluded16(valid,*ray,&context);
     else
       scene->device->rayStreamFilters.occludedSOA(scene,(char*)ray,16,1,sizeof(RTCRay16),&context);
 #endif
@@ -683,7 +1020,7 @@ namespace embree
     /* fast codepath for streams of size 1 */
     if (likely(M == 1)) {
       if (likely(ray->tnear <= ray->tfar)) 
-        scene->intersectors.occluded (*ray,&context);
+        scene->localIntersectors().occluded (*ray,&context);
     } 
     /* codepath for normal streams */
     else {
@@ -713,7 +1050,7 @@ namespace embree
     /* fast codepath for streams of size 1 */
     if (likely(M == 1)) {
       if (likely(ray[0]->tnear <= ray[0]->tfar)) 
-        scene->intersectors.occluded (*ray[0],&context);
+        scene->localIntersectors().occluded (*ray[0],&context);
     } 
     /* codepath for normal streams */
     else {
@@ -738,7 +1075,7 @@ namespace embree
     if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
-    STAT3(shadow.travs,N*M,N*N,N*N);
+    STAT3(shadow.travs,N*M,N*M,N*M);
     IntersectContext context(scene,user_context);
 
     /* codepath for single rays */
@@ -747,7 +1084,7 @@ namespace embree
       /* fast path for streams of size 1 */
       if (likely(M == 1)) {
         if (likely(((RTCRay*)ray)->tnear <= ((RTCRay*)ray)->tfar))
-          scene->intersectors.occluded (*(RTCRay*)ray,&context);
+          scene->localIntersectors().occluded (*(RTCRay*)ray,&context);
       } 
       /* codepath for normal ray streams */
       else {
@@ -794,6 +1131,22 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API bool rtcPointQuery(RTCScene hscene, RTCPointQuery* query, RTCPointQueryFunction queryFunc, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQuery);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+#endif
+    PointQueryContext context(scene,queryFunc,userPtr);
+    return scene->localIntersectors().pointQuery(query,&context);
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
   RTC_API void rtcRetainScene (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1000,6 +1353,27 @@ namespace embree
       throw_RTCError(RTC_ERROR_UNKNOWN,"RTC_GEOMETRY_TYPE_CURVE is not supported");
 #endif
     }
+
+    case RTC_GEOMETRY_TYPE_SPHERE_POINT:
+    case RTC_GEOMETRY_TYPE_DISC_POINT:
+    case RTC_GEOMETRY_TYPE_ORIENTED_DISC_POINT:
+    {
+#if defined(EMBREE_GEOMETRY_CURVE)
+      createPointsTy createPoints = nullptr;
+      SELECT_SYMBOL_DEFAULT_AVX_AVX2_AVX512KNL_AVX512SKX(device->enabled_cpu_features,createPoints);
+
+      Geometry* geom;
+      switch (type) {
+      case RTC_GEOMETRY_TYPE_SPHERE_POINT        : geom = createPoints(device,Geometry::GTY_SPHERE_POINT); break;
+      case RTC_GEOMETRY_TYPE_DISC_POINT          : geom = createPoints(device,Geometry::GTY_DISC_POINT); break;
+      case RTC_GEOMETRY_TYPE_ORIENTED_DISC_POINT : geom = createPoints(device,Geometry::GTY_ORIENTED_DISC_POINT); break;
+      default:                                     geom = nullptr; break;
+      }
+      return (RTCGeometry) geom->refInc();
+#else
+      throw_RTCError(RTC_ERROR_UNKNOWN,"RTC_GEOMETRY_TYPE_POINT is not supported");
+#endif
+    }
     
     case RTC_GEOMETRY_TYPE_SUBDIVISION:
     {
@@ -1390,6 +1764,16 @@ namespace embree
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryPointQueryFunction (RTCGeometry hgeometry, RTCPointQueryFunction pointQuery) 
+  {
+    Ref<Geometry> geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryPointQueryFunction);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setPointQueryFunction(pointQuery);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcInterpolate(const RTCInterpolateArguments* const args)
   {
     Geometry* geometry = (Geometry*) args->geometry;
@@ -35,7 +35,8 @@ namespace embree
       flags_modified(true),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
-      is_build(false), modified(true),
+      is_build(false), modified(true), instanceLevelCount(0),
+      buildMemoryBudget(0), memoryBudgetLevel(MEMORY_BUDGET_NONE),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
       numIntersectionFiltersN(0)
   {
@@ -118,7 +119,7 @@ namespace embree
     }
   }
 
-  void Scene::createTriangleAccel()
+  void Scene::createTriangleAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     if (device->tri_accel == "default") 
@@ -201,7 +202,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createTriangleMBAccel()
+  void Scene::createTriangleMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     if (device->tri_accel_mb == "default")
@@ -239,7 +240,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createQuadAccel()
+  void Scene::createQuadAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_QUAD)
     if (device->quad_accel == "default") 
@@ -320,7 +321,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createQuadMBAccel()
+  void Scene::createQuadMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_QUAD)
     if (device->quad_accel_mb == "default") 
@@ -357,7 +358,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createHairAccel()
+  void Scene::createHairAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_CURVE)
     if (device->hair_accel == "default")
@@ -394,7 +395,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createHairMBAccel()
+  void Scene::createHairMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_CURVE)
     if (device->hair_accel_mb == "default")
@@ -418,7 +419,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createSubdivAccel()
+  void Scene::createSubdivAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_SUBDIVISION)
     if (device->subdiv_accel == "default") {
@@ -430,7 +431,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createSubdivMBAccel()
+  void Scene::createSubdivMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_SUBDIVISION)
     if (device->subdiv_accel_mb == "default") {
@@ -440,7 +441,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createUserGeometryAccel()
+  void Scene::createUserGeometryAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_USER)
     if (device->object_accel == "default") 
@@ -472,7 +473,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createUserGeometryMBAccel()
+  void Scene::createUserGeometryMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_USER)
     if (device->object_accel_mb == "default"    ) {
@@ -491,7 +492,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createInstanceAccel()
+  void Scene::createInstanceAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_INSTANCE)
     //if (device->object_accel == "default") 
@@ -507,7 +508,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createInstanceMBAccel()
+  void Scene::createInstanceMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_INSTANCE)
     //if (device->instance_accel_mb == "default")
@@ -523,7 +524,7 @@ namespace embree
 #endif
   }
 
-  void Scene::createGridAccel()
+  void Scene::createGridAccel(AccelN& accels)
   {
     BVHFactory::IntersectVariant ivariant = isRobustAccel() ? BVHFactory::IntersectVariant::ROBUST : BVHFactory::IntersectVariant::FAST;
 #if defined(EMBREE_GEOMETRY_GRID)
@@ -549,7 +550,7 @@ namespace embree
 
   }
 
-  void Scene::createGridMBAccel()
+  void Scene::createGridMBAccel(AccelN& accels)
   {
 #if defined(EMBREE_GEOMETRY_GRID)
     if (device->grid_accel_mb == "default") 
@@ -612,14 +613,114 @@ namespace embree
     intersectors = accels.intersectors;
   }
 
+  void Scene::createReplicas()
+  {
+    const size_t numNodes = getNumberOfNumaNodes();
+    for (size_t node=0; node<numNodes; node++)
+    {
+      AccelN* replica = nullptr;
+      os_set_numa_node(node);
+      try {
+        replica = accels.replicate();
+      } catch (...) {
+        os_set_numa_node(-1);
+        throw;
+      }
+      os_set_numa_node(-1);
+
+      /* use no replicas if some acceleration structure cannot get replicated */
+      if (!replica) {
+        replicas.clear();
+        return;
+      }
+      replicas.push_back(std::unique_ptr<AccelN>(replica));
+    }
+  }
+
+  void Scene::createAccels(AccelN& accels)
+  {
+    createTriangleAccel(accels);
+    createTriangleMBAccel(accels);
+    createQuadAccel(accels);
+    createQuadMBAccel(accels);
+    createGridAccel(accels);
+    createGridMBAccel(accels);
+    createSubdivAccel(accels);
+    createSubdivMBAccel(accels);
+    createHairAccel(accels);
+    createHairMBAccel(accels);
+    createUserGeometryAccel(accels);
+    createUserGeometryMBAccel(accels);
+    createInstanceAccel(accels);
+    createInstanceMBAccel(accels);
+  }
+
+  size_t Scene::selectMemoryBudgetLevel(AccelN& accels)
+  {
+    memoryBudgetLevel = MEMORY_BUDGET_NONE;
+    size_t bytes = accels.estimateMemory();
+    while (bytes > buildMemoryBudget && memoryBudgetLevel < MEMORY_BUDGET_LARGE_LEAVES) {
+      memoryBudgetLevel++;
+      bytes = accels.estimateMemory();
+    }
+    return bytes;
+  }
+
+  size_t Scene::estimateBuildMemory()
+  {
+    Lock<MutexSys> buildLock(buildMutex);
+
+    /* estimate using temporary acceleration structures as the current ones may hold a committed BVH */
+    AccelN estimateAccels;
+    createAccels(estimateAccels);
+    if (buildMemoryBudget == 0)
+      return estimateAccels.estimateMemory();
+
+    const int level = memoryBudgetLevel;
+    const size_t bytes = selectMemoryBudgetLevel(estimateAccels);
+    memoryBudgetLevel = level;
+    return bytes;
+  }
+
+  void Scene::setBuildMemoryBudget(size_t bytes)
+  {
+    if (buildMemoryBudget == bytes) return;
+    buildMemoryBudget = bytes;
+    setModified();
+  }
+
+  RTCBuildStatistics Scene::getBuildStatistics()
+  {
+    Lock<MutexSys> buildLock(buildMutex);
+    return buildStats.get();
+  }
+
   void Scene::commit_task ()
   {
+    buildStats.begin();
+
+    /* replicas share leaves with the acceleration structures we are about to rebuild */
+    replicas.clear();
+
     /* print scene statistics */
     if (device->verbosity(2))
       printStatistics();
 
     progress_monitor_counter = 0;
 
+    /* determine number of nested instance levels */
+    unsigned int levels = 0;
+    for (size_t i = 0; i < geometries.size(); i++)
+    {
+      if (!geometries[i] || !geometries[i]->isEnabled()) continue;
+      if (geometries[i]->getType() != Geometry::GTY_INSTANCE) continue;
+      Instance* instance = (Instance*) geometries[i].ptr;
+      if (instance->object) levels = max(levels,((Scene*)instance->object)->instanceLevelCount+1);
+    }
+    if (levels > RTC_MAX_INSTANCE_LEVEL_COUNT)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"maximal number of instance levels exceeded");
+    instanceLevelCount = levels;
+
     /* call preCommit function of each geometry */
     parallel_for(geometries.size(), [&] ( const size_t i ) {
         if (geometries[i] && geometries[i]->isEnabled())
@@ -630,28 +731,32 @@ namespace embree
     if (flags_modified)
     {    
       accels.init();
-      createTriangleAccel();
-      createTriangleMBAccel();
-      createQuadAccel();
-      createQuadMBAccel();
-      createGridAccel();
-      createGridMBAccel();
-      createSubdivAccel();
-      createSubdivMBAccel();
-      createHairAccel();
-      createHairMBAccel();
-      createUserGeometryAccel();
-      createUserGeometryMBAccel();
-      createInstanceAccel();
-      createInstanceMBAccel();
+      createAccels(accels);
       flags_modified = false;
     }
+
+    /* degrade the build to stay within the memory budget */
+    memoryBudgetLevel = MEMORY_BUDGET_NONE;
+    if (buildMemoryBudget) {
+      const size_t bytes = selectMemoryBudgetLevel(accels);
+      if (device->verbosity(2))
+        std::cout << "build memory estimate " << 1E-6*double(bytes) << " MB, budget level " << memoryBudgetLevel << std::endl;
+    }
     
     /* select fast code path if no filter function is present */
     accels.select(hasFilterFunction());
   
-    /* build all hierarchies of this scene */
-    accels.build();
+    /* build all hierarchies of this scene, or use the ones of a file */
+    if (loadFile) {
+      Ref<AccelFile> file = loadFile; loadFile = nullptr;
+      accels.load(file.ptr);
+    }
+    else
+      accels.build();
+
+    /* gather memory consumption before the builders get released */
+    size_t bytesAllocated = 0, bytesUsed = 0;
+    accels.addMemoryUsage(bytesAllocated,bytesUsed);
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
@@ -667,16 +772,108 @@ namespace embree
       
     updateInterface();
 
+    if ((scene_flags & RTC_SCENE_FLAG_NUMA_REPLICATION) && getNumberOfNumaNodes() > 1)
+      createReplicas();
+
     if (device->verbosity(2)) {
       std::cout << "created scene intersector" << std::endl;
       accels.print(2);
       std::cout << "selected scene intersector" << std::endl;
       intersectors.print(2);
     }
-    
+
+    buildStats.end(bytesAllocated,bytesUsed);
     setModified(false);
   }
 
+  /*! header of an acceleration structure file */
+  struct SceneFileHeader
+  {
+    char magic[8];          //!< identifies file type
+    size_t version;         //!< version of file format
+    size_t numGeometries;   //!< number of geometry slots of the scene
+  };
+
+  /*! summary of some geometry, used to detect files written for other scenes */
+  struct SceneFileGeometry
+  {
+    int type;               //!< geometry type, -1 for unused slots
+    unsigned int enabled;   //!< geometry enabled state
+    unsigned int numPrimitives;
+    unsigned int numTimeSteps;
+  };
+
+  static const char sceneFileMagic[8] = { 'E','M','B','R','E','E','A','S' };
+  static const size_t sceneFileVersion = 1;
+
+  static std::vector<SceneFileGeometry> sceneFileGeometries(Scene* scene)
+  {
+    std::vector<SceneFileGeometry> geometries(scene->size());
+    for (size_t i=0; i<scene->size(); i++)
+    {
+      Geometry* geom = scene->get(i);
+      geometries[i].type          = geom ? (int) geom->getType() : -1;
+      geometries[i].enabled       = geom ? (unsigned) geom->isEnabled() : 0;
+      geometries[i].numPrimitives = geom ? (unsigned) geom->size() : 0;
+      geometries[i].numTimeSteps  = geom ? geom->numTimeSteps : 0;
+    }
+    return geometries;
+  }
+
+  void Scene::saveBVH (const std::string& fileName)
+  {
+    Lock<MutexSys> buildLock(buildMutex);
+    if (!isBuild() || isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+
+    std::ofstream out(fileName.c_str(),std::ios::out | std::ios::binary);
+    if (!out.is_open())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"cannot open file "+fileName);
+
+    SceneFileHeader header;
+    memcpy(header.magic,sceneFileMagic,sizeof(header.magic));
+    header.version = sceneFileVersion;
+    header.numGeometries = size();
+    AccelFile::write(out,&header,sizeof(header));
+
+    const std::vector<SceneFileGeometry> geometries = sceneFileGeometries(this);
+    AccelFile::write(out,geometries.data(),geometries.size()*sizeof(SceneFileGeometry));
+
+    accels.save(out);
+
+    out.close();
+    if (out.fail())
+      throw_RTCError(RTC_ERROR_UNKNOWN,"error writing file "+fileName);
+  }
+
+  void Scene::loadBVH (const std::string& fileName)
+  {
+    Ref<AccelFile> file = new AccelFile(fileName);
+    
+    const SceneFileHeader* header = (const SceneFileHeader*) file->next(sizeof(SceneFileHeader));
+    if (memcmp(header->magic,sceneFileMagic,sizeof(header->magic)) != 0 || header->version != sceneFileVersion)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid acceleration structure file "+fileName);
+
+    const std::vector<SceneFileGeometry> geometries = sceneFileGeometries(this);
+    if (header->numGeometries != geometries.size())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure file does not match scene");
+    const char* stored = file->next(geometries.size()*sizeof(SceneFileGeometry));
+    if (memcmp(stored,geometries.data(),geometries.size()*sizeof(SceneFileGeometry)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure file does not match scene");
+
+    /* the loaded hierarchies go into freshly created acceleration structures */
+    flags_modified = true;
+    setModified();
+    loadFile = file;
+    try {
+      commit(false);
+    }
+    catch (...) {
+      loadFile = nullptr;
+      throw;
+    }
+  }
+
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
   {
     if (quality_flags == quality_flags_i) return;
@@ -705,14 +902,14 @@ namespace embree
   {
     Lock<MutexSys> buildLock(buildMutex,false);
 
-    /* allocates own taskscheduler for each build */
+    /* allocates own taskscheduler for each build, worker threads prefer rendering tasks over builds */
     Ref<TaskScheduler> scheduler = nullptr;
     { 
       Lock<MutexSys> lock(schedulerMutex);
       scheduler = this->scheduler;
       if (scheduler == null) {
         buildLock.lock();
-        this->scheduler = scheduler = new TaskScheduler;
+        this->scheduler = scheduler = new TaskScheduler(TaskScheduler::PRIORITY_BACKGROUND);
       }
     }
 
@@ -838,6 +1035,63 @@ namespace embree
   }
 #endif
 
+  CommitFuture::CommitFuture (Scene* scene)
+    : scene(scene), thread(nullptr), ready(false), error(RTC_ERROR_NONE)
+  {
+    /* the build itself runs on the task scheduler, the thread only waits for it */
+    thread = createThread((thread_func)commitThread,this,4*1024*1024);
+  }
+
+  CommitFuture::~CommitFuture ()
+  {
+    Lock<MutexSys> lock(mutex);
+    if (thread) {
+      embree::join(thread);
+      thread = nullptr;
+    }
+    if (error != RTC_ERROR_NONE)
+      Device::process_error(scene->device,error,message.c_str());
+  }
+
+  void CommitFuture::commitThread(CommitFuture* future)
+  {
+    try {
+      future->scene->commit(false);
+    }
+    catch (std::bad_alloc&) {
+      future->error = RTC_ERROR_OUT_OF_MEMORY;
+      future->message = "out of memory";
+    }
+    catch (rtcore_error& e) {
+      future->error = e.error;
+      future->message = e.what();
+    }
+    catch (std::exception& e) {
+      future->error = RTC_ERROR_UNKNOWN;
+      future->message = e.what();
+    }
+    catch (...) {
+      future->error = RTC_ERROR_UNKNOWN;
+      future->message = "unknown exception caught";
+    }
+    future->ready = true;
+  }
+
+  void CommitFuture::wait()
+  {
+    Lock<MutexSys> lock(mutex);
+    if (thread) {
+      embree::join(thread);
+      thread = nullptr;
+    }
+
+    /* report error of the commit only once */
+    if (error != RTC_ERROR_NONE) {
+      const RTCError e = error; error = RTC_ERROR_NONE;
+      throw_RTCError(e,message);
+    }
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr) 
   {
     progress_monitor_function = func;
@@ -25,12 +25,14 @@
 #include "scene_instance.h"
 #include "scene_curves.h"
 #include "scene_line_segments.h"
+#include "scene_points.h"
 #include "scene_subdiv_mesh.h"
 #include "scene_grid_mesh.h"
 #include "../subdiv/tessellation_cache.h"
 
 #include "acceln.h"
 #include "geometry.h"
+#include "buildstat.h"
 
 namespace embree
 {
@@ -145,20 +147,23 @@ namespace embree
     Scene& operator= (const Scene& other) DELETED; // do not implement
 
   public:
-    void createTriangleAccel();
-    void createTriangleMBAccel();
-    void createQuadAccel();
-    void createQuadMBAccel();
-    void createHairAccel();
-    void createHairMBAccel();
-    void createSubdivAccel();
-    void createSubdivMBAccel();
-    void createUserGeometryAccel();
-    void createUserGeometryMBAccel();
-    void createInstanceAccel();
-    void createInstanceMBAccel();
-    void createGridAccel();
-    void createGridMBAccel();
+    void createTriangleAccel(AccelN& accels);
+    void createTriangleMBAccel(AccelN& accels);
+    void createQuadAccel(AccelN& accels);
+    void createQuadMBAccel(AccelN& accels);
+    void createHairAccel(AccelN& accels);
+    void createHairMBAccel(AccelN& accels);
+    void createSubdivAccel(AccelN& accels);
+    void createSubdivMBAccel(AccelN& accels);
+    void createUserGeometryAccel(AccelN& accels);
+    void createUserGeometryMBAccel(AccelN& accels);
+    void createInstanceAccel(AccelN& accels);
+    void createInstanceMBAccel(AccelN& accels);
+    void createGridAccel(AccelN& accels);
+    void createGridMBAccel(AccelN& accels);
+
+    /*! adds the acceleration structures selected by the scene flags to accels */
+    void createAccels(AccelN& accels);
 
     /*! prints statistics about the scene */
     void printStatistics();
@@ -177,6 +182,21 @@ namespace embree
     
     void commit (bool join);
     void commit_task ();
+
+    /*! returns the predicted peak memory consumption of the next commit in bytes */
+    size_t estimateBuildMemory();
+
+    /*! limits the memory the builders of this scene may use, 0 means no limit */
+    void setBuildMemoryBudget(size_t bytes);
+
+    /*! returns the build statistics of the last commit */
+    RTCBuildStatistics getBuildStatistics();
+
+    /*! writes the acceleration structures of the committed scene to a file */
+    void saveBVH (const std::string& fileName);
+
+    /*! commits the scene using the acceleration structures of a file */
+    void loadBVH (const std::string& fileName);
     void build () {}
 
     void updateInterface();
@@ -232,6 +252,11 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+
+    /*! true if builders should allocate the BVH inside finished parts of the primref array */
+    __forceinline bool isLowMemoryBuild() const {
+      return (scene_flags & RTC_SCENE_FLAG_LOW_MEMORY_BUILD) || memoryBudgetLevel >= MEMORY_BUDGET_SHARED_PRIMREFS;
+    }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -246,6 +271,35 @@ namespace embree
     /* test if scene got already build */
     __forceinline bool isBuild() const { return is_build; }
 
+    /* returns the intersectors of the acceleration structure replica of the NUMA node the calling thread runs on */
+    __forceinline Accel::Intersectors& localIntersectors() 
+    {
+      if (likely(replicas.size() == 0)) return intersectors;
+      return replicas[min(getNumaNodeOfCallingThread(),replicas.size()-1)]->intersectors;
+    }
+
+    /*! factor by which builders enlarge their leaves to stay within the memory budget */
+    __forceinline size_t leafSizeScale() const {
+      return memoryBudgetLevel >= MEMORY_BUDGET_LARGE_LEAVES ? 4 : 1;
+    }
+
+  private:
+    /* copies the inner nodes of all acceleration structures into the memory of each NUMA node */
+    void createReplicas();
+
+    /* selects the least degraded build mode whose memory estimate fits into the memory budget, returns the estimate */
+    size_t selectMemoryBudgetLevel(AccelN& accels);
+
+  public:
+    /*! build modes used to stay within the memory budget, each level includes all previous ones */
+    enum MemoryBudgetLevel
+    {
+      MEMORY_BUDGET_NONE = 0,              //!< builders use their default settings
+      MEMORY_BUDGET_NO_SPATIAL_SPLITS = 1, //!< builders reserve no space for spatial splits
+      MEMORY_BUDGET_SHARED_PRIMREFS = 2,   //!< builders allocate the BVH inside finished parts of the primref array
+      MEMORY_BUDGET_LARGE_LEAVES = 3       //!< builders create larger leaves
+    };
+
   public:
     IDPool<unsigned,0xFFFFFFFE> id_pool;
     vector<Ref<Geometry>> geometries; //!< list of all user geometries
@@ -261,6 +315,12 @@ namespace embree
     SpinLock geometriesMutex;
     bool is_build;
     bool modified;                   //!< true if scene got modified
+    unsigned int instanceLevelCount; //!< number of nested instance levels below this scene
+    Ref<AccelFile> loadFile;         //!< file to load acceleration structures from at next commit
+    std::vector<std::unique_ptr<AccelN>> replicas; //!< per NUMA node copies of the acceleration structures
+    size_t buildMemoryBudget;        //!< maximal number of bytes the builders should use, 0 means no limit
+    int memoryBudgetLevel;           //!< build mode selected to stay within the memory budget
+    BuildStatistics buildStats;      //!< timings and memory consumption of the commit
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL) 
@@ -293,16 +353,17 @@ namespace embree
     struct GeometryCounts 
     {
       __forceinline GeometryCounts()
-        : numTriangles(0), numQuads(0), numBezierCurves(0), numLineSegments(0), numSubdivPatches(0), numUserGeometries(0), numInstances(0), numGrids(0) {}
+        : numTriangles(0), numQuads(0), numBezierCurves(0), numLineSegments(0), numPoints(0), numSubdivPatches(0), numUserGeometries(0), numInstances(0), numGrids(0) {}
 
       __forceinline size_t size() const {
-        return numTriangles + numQuads + numBezierCurves + numLineSegments + numSubdivPatches + numUserGeometries + numInstances + numGrids;
+        return numTriangles + numQuads + numBezierCurves + numLineSegments + numPoints + numSubdivPatches + numUserGeometries + numInstances + numGrids;
       }
 
       std::atomic<size_t> numTriangles;             //!< number of enabled triangles
       std::atomic<size_t> numQuads;                 //!< number of enabled quads
       std::atomic<size_t> numBezierCurves;          //!< number of enabled curves
       std::atomic<size_t> numLineSegments;          //!< number of enabled line segments
+      std::atomic<size_t> numPoints;                //!< number of enabled points
       std::atomic<size_t> numSubdivPatches;         //!< number of enabled subdivision patches
       std::atomic<size_t> numUserGeometries;        //!< number of enabled user geometries
       std::atomic<size_t> numInstances;             //!< number of enabled instances
@@ -338,10 +399,12 @@ namespace embree
   template<> __forceinline size_t Scene::getNumPrimitives<TriangleMesh,true>() const { return worldMB.numTriangles; }
   template<> __forceinline size_t Scene::getNumPrimitives<QuadMesh,false>() const { return world.numQuads; }
   template<> __forceinline size_t Scene::getNumPrimitives<QuadMesh,true>() const { return worldMB.numQuads; }
-  template<> __forceinline size_t Scene::getNumPrimitives<CurveGeometry,false>() const { return world.numBezierCurves+world.numLineSegments; }
-  template<> __forceinline size_t Scene::getNumPrimitives<CurveGeometry,true>() const { return worldMB.numBezierCurves+worldMB.numLineSegments; }
+  template<> __forceinline size_t Scene::getNumPrimitives<CurveGeometry,false>() const { return world.numBezierCurves+world.numLineSegments+world.numPoints; }
+  template<> __forceinline size_t Scene::getNumPrimitives<CurveGeometry,true>() const { return worldMB.numBezierCurves+worldMB.numLineSegments+worldMB.numPoints; }
   template<> __forceinline size_t Scene::getNumPrimitives<LineSegments,false>() const { return world.numLineSegments; }
   template<> __forceinline size_t Scene::getNumPrimitives<LineSegments,true>() const { return worldMB.numLineSegments; }
+  template<> __forceinline size_t Scene::getNumPrimitives<Points,false>() const { return world.numPoints; }
+  template<> __forceinline size_t Scene::getNumPrimitives<Points,true>() const { return worldMB.numPoints; }
   template<> __forceinline size_t Scene::getNumPrimitives<SubdivMesh,false>() const { return world.numSubdivPatches; }
   template<> __forceinline size_t Scene::getNumPrimitives<SubdivMesh,true>() const { return worldMB.numSubdivPatches; }
   template<> __forceinline size_t Scene::getNumPrimitives<UserGeometry,false>() const { return world.numUserGeometries; }
@@ -350,4 +413,35 @@ namespace embree
   template<> __forceinline size_t Scene::getNumPrimitives<Instance,true>() const { return worldMB.numInstances; }
   template<> __forceinline size_t Scene::getNumPrimitives<GridMesh,false>() const { return world.numGrids; }
   template<> __forceinline size_t Scene::getNumPrimitives<GridMesh,true>() const { return worldMB.numGrids; }
+
+  /*! Commits a scene in a background thread */
+  class CommitFuture : public RefCount
+  {
+  public:
+
+    /*! starts the commit of the scene */
+    CommitFuture (Scene* scene);
+
+    /*! waits for the commit to finish */
+    ~CommitFuture ();
+
+    /*! returns true if the commit has finished */
+    __forceinline bool isReady() const { return ready; }
+
+    /*! waits for the commit to finish and reports its error */
+    void wait();
+
+  private:
+    static void commitThread(CommitFuture* future);
+
+  public:
+    Ref<Scene> scene;
+
+  private:
+    thread_t thread;
+    std::atomic<bool> ready;
+    MutexSys mutex;
+    RTCError error;      //!< error of the commit, reported by wait
+    std::string message; //!< error message of the commit
+  };
 }
@@ -19,6 +19,15 @@
 namespace embree
 {
   Stat Stat::instance; 
+
+  std::atomic<bool> TravStat::enabled(false);
+  __thread TravStat::Counters* TravStat::thread_counters = nullptr;
+
+  /* counters of all threads that ever gathered statistics, the
+   * counters stay alive after their thread exited to not lose their
+   * numbers */
+  static MutexSys travStatMutex;
+  static std::vector<std::unique_ptr<TravStat::Counters>> travStatCounters;
   
   Stat::Stat () {
   }
@@ -138,4 +147,38 @@ namespace embree
     cout << "#user7/user3 " << 100.0f*float(cntrs.user[7])/float(cntrs.user[3]) << "%" << std::endl;
     cout << std::endl;
   }
+
+  void TravStat::Counters::clear() {
+    memset((void*)this,0,sizeof(Counters));
+  }
+
+  void TravStat::Counters::add(const Counters& other)
+  {
+    const size_t N = sizeof(Counters)/sizeof(size_t);
+    size_t* dst = (size_t*) this;
+    const size_t* src = (const size_t*) &other;
+    for (size_t i=0; i<N; i++) dst[i] += src[i];
+  }
+
+  TravStat::Counters* TravStat::createThreadCounters()
+  {
+    Lock<MutexSys> lock(travStatMutex);
+    travStatCounters.emplace_back(new Counters);
+    return travStatCounters.back().get();
+  }
+
+  void TravStat::clear()
+  {
+    Lock<MutexSys> lock(travStatMutex);
+    for (auto& counters : travStatCounters)
+      counters->clear();
+  }
+
+  void TravStat::sum(Counters& counters)
+  {
+    counters.clear();
+    Lock<MutexSys> lock(travStatMutex);
+    for (auto& c : travStatCounters)
+      counters.add(*c);
+  }
 }
@@ -18,17 +18,22 @@
 
 #include "default.h"
 
+/* Macro to gather runtime switchable traversal statistics */
+#define TRAV_STAT(s,y) \
+  { if (unlikely(TravStat::isEnabled())) TravStat::get().s+=y; }
+
 /* Macros to gather statistics */
 #ifdef EMBREE_STAT_COUNTERS
 #  define STAT(x) x
 #  define STAT3(s,x,y,z) \
   STAT(Stat::get().code  .s+=x);               \
   STAT(Stat::get().active.s+=y);               \
-  STAT(Stat::get().all   .s+=z);
+  STAT(Stat::get().all   .s+=z);               \
+  TRAV_STAT(s,y);
 #  define STAT_USER(i,x) Stat::get().user[i]+=x;
 #else
 #  define STAT(x)
-#  define STAT3(s,x,y,z)
+#  define STAT3(s,x,y,z) TRAV_STAT(s,y)
 #  define STAT_USER(i,x) 
 #endif
 
@@ -125,4 +130,83 @@ namespace embree
   private:
     static Stat instance;
   };
+
+  /*! Traversal statistics that can get enabled at runtime. Each
+   *  thread accumulates into its own counters without any
+   *  synchronization, the counters of all threads get summed up on
+   *  demand. The counters use the per ray (active lane) numbers of
+   *  the STAT3 macro. */
+  class TravStat
+  {
+  public:
+
+    static const size_t MAX_GEOMETRY_TYPES = 32;
+
+    struct __aligned(64) Counters
+    {
+      ALIGNED_STRUCT_(64);
+
+      Counters () {
+        clear();
+      }
+
+      void clear();
+
+      /*! adds the counters of another thread */
+      void add(const Counters& other);
+
+    public:
+
+      /* normal and shadow ray statistics */
+      struct Data
+      {
+        size_t travs;
+        size_t trav_nodes;
+        size_t trav_leaves;
+        size_t trav_prims;
+        size_t trav_prim_hits;
+        size_t trav_hit_boxes[Stat::SIZE_HISTOGRAM+1];
+        size_t trav_stack_pop;
+        size_t trav_stack_nodes;
+        size_t trav_xfm_nodes;
+      } normal, shadow;
+
+      size_t filter_calls;                    //!< number of filter function invocations
+      size_t hits[MAX_GEOMETRY_TYPES];        //!< number of hits per geometry type
+      size_t instance_hits;                   //!< number of hits inside instanced scenes
+    };
+
+  public:
+
+    /*! checks if counters are currently gathered */
+    static __forceinline bool isEnabled() {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    /*! enables or disables gathering of the counters */
+    static void setEnabled(bool enable) {
+      enabled.store(enable);
+    }
+
+    /*! returns the counters of the calling thread */
+    static __forceinline Counters& get()
+    {
+      if (unlikely(thread_counters == nullptr))
+        thread_counters = createThreadCounters();
+      return *thread_counters;
+    }
+
+    /*! clears the counters of all threads */
+    static void clear();
+
+    /*! returns the sum of the counters of all threads */
+    static void sum(Counters& counters);
+
+  private:
+    static Counters* createThreadCounters();
+
+  private:
+    static std::atomic<bool> enabled;
+    static __thread Counters* thread_counters;
+  };
 }
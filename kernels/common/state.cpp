@@ -94,6 +94,8 @@ namespace embree
     object_accel_mb_max_leaf_size = 1;
 
     max_spatial_split_replications = 2.0f;
+    refit_rebuild_ratio = 2.0f;
+    tree_rotation_budget = 0.0f;
 
     tessellation_cache_size = 128*1024*1024;
 
@@ -135,11 +137,19 @@ namespace embree
     hugepages = false;
 #endif
     hugepages_success = true;
+    numa = 0;
+    numa_success = true;
+    out_of_core_directory = "";
+    out_of_core_success = true;
+    out_of_core_chunk_size = 1024*1024;
 
     alloc_main_block_size = 0;
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    alloc_arena_size = 0;
+
+    traversal_statistics = false;
 
     error_function = nullptr;
     error_function_userptr = nullptr;
@@ -278,6 +288,15 @@ namespace embree
       else if (tok == Token::Id("hugepages") && cin->trySymbol("=")) {
         hugepages = cin->get().Int();
       }
+      else if (tok == Token::Id("numa") && cin->trySymbol("=")) {
+        numa = cin->get().Int();
+      }
+      else if (tok == Token::Id("out_of_core_directory") && cin->trySymbol("=")) {
+        out_of_core_directory = cin->get().String();
+      }
+      else if (tok == Token::Id("out_of_core_chunk_size") && cin->trySymbol("=")) {
+        out_of_core_chunk_size = max(cin->get().Int(),1);
+      }
 
       else if (tok == Token::Id("ignore_config_files") && cin->trySymbol("="))
         ignore_config_files = cin->get().Int();
@@ -412,6 +431,12 @@ namespace embree
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
 
+      else if (tok == Token::Id("refit_rebuild_ratio") && cin->trySymbol("="))
+        refit_rebuild_ratio = cin->get().Float();
+
+      else if (tok == Token::Id("tree_rotation_budget") && cin->trySymbol("="))
+        tree_rotation_budget = cin->get().Float();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
@@ -425,6 +450,11 @@ namespace embree
          alloc_thread_block_size = cin->get().Int();
        else if (tok == Token::Id("alloc_single_thread_alloc") && cin->trySymbol("="))
          alloc_single_thread_alloc = cin->get().Int();
+       else if (tok == Token::Id("alloc_arena_size") && cin->trySymbol("="))
+         alloc_arena_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+
+       else if (tok == Token::Id("traversal_statistics") && cin->trySymbol("="))
+         traversal_statistics = cin->get().Int();
 
       cin->trySymbol(","); // optional , separator
     }
@@ -446,9 +476,27 @@ namespace embree
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
 
+    std::cout << "  numa          = ";
+    if (!numa) std::cout << "disabled" << std::endl;
+    else if (numa == 1) std::cout << "first touch" << std::endl;
+    else if (numa_success) std::cout << "interleave" << std::endl;
+    else std::cout << "failed" << std::endl;
+
+    std::cout << "  out_of_core   = ";
+    if (out_of_core_directory == "") std::cout << "disabled" << std::endl;
+    else if (out_of_core_success) std::cout << out_of_core_directory << " (" << out_of_core_chunk_size << " primitives per chunk)" << std::endl;
+    else std::cout << "failed" << std::endl;
+
+    std::cout << "  alloc_arena   = ";
+    if (alloc_arena_size == 0) std::cout << "disabled" << std::endl;
+    else std::cout << float(alloc_arena_size)*1E-6 << " MB" << std::endl;
+
+    std::cout << "  trav_stats    = " << (traversal_statistics ? "enabled" : "disabled") << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  refit_rebuild_ratio = " << refit_rebuild_ratio << std::endl;
+    std::cout << "  tree_rotation_budget = " << tree_rotation_budget << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
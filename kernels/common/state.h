@@ -117,6 +117,8 @@ namespace embree
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
+    float refit_rebuild_ratio;             //!< rebuilds refitted BVHs whose SAH cost grew by more than this ratio, 0 disables rebuilds
+    float tree_rotation_budget;            //!< time for tree rotations after Morton builds and refits relative to the build time
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
 
   public:
@@ -143,12 +145,21 @@ namespace embree
     bool enable_selockmemoryprivilege;     //!< configures the SeLockMemoryPrivilege under Windows to enable huge pages
     bool hugepages;                        //!< true if huge pages should get used
     bool hugepages_success;                //!< status for enabling huge pages
+    int numa;                              //!< NUMA mode: 0 = disabled, 1 = node by node thread pinning, 2 = additionally interleave memory
+    bool numa_success;                     //!< status for enabling NUMA memory interleaving
+    std::string out_of_core_directory;     //!< directory for files backing BVH memory, empty disables out-of-core builds
+    bool out_of_core_success;              //!< status for enabling file backed memory
+    size_t out_of_core_chunk_size;         //!< number of primitives per sub-BVH of out-of-core builds
 
   public:
     size_t alloc_main_block_size;          //!< main allocation block size (shared between threads)
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    size_t alloc_arena_size;               //!< maximal bytes of pre-faulted blocks kept for reuse across builds, 0 disables the arena
+
+  public:
+    bool traversal_statistics;             //!< gathers traversal counters from device creation on
 
   public:
     struct ErrorHandler
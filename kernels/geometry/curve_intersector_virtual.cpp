@@ -22,6 +22,7 @@
 #include "../subdiv/hermite_curve.h"
 
 #include "linei_intersector.h"
+#include "pointi_intersector.h"
 
 #include "curveNi_intersector.h"
 #include "curveNv_intersector.h"
@@ -340,6 +341,120 @@ namespace embree
       return intersectors;
     }
 
+    template<int N>
+    static VirtualCurveIntersector::Intersectors SphereNiIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty)&PointMiIntersector1<N,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty) &PointMiIntersector1<N,true,SphereIntersector<N>>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&PointMiIntersectorK<N,4,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &PointMiIntersectorK<N,4,true,SphereIntersector<N>>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&PointMiIntersectorK<N,8,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &PointMiIntersectorK<N,8,true,SphereIntersector<N>>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&PointMiIntersectorK<N,16,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &PointMiIntersectorK<N,16,true,SphereIntersector<N>>::occluded;
+#endif
+      return intersectors;
+    }
+
+    template<int N>
+    static VirtualCurveIntersector::Intersectors SphereNiMBIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty)&PointMiMBIntersector1<N,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty) &PointMiMBIntersector1<N,true,SphereIntersector<N>>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&PointMiMBIntersectorK<N,4,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &PointMiMBIntersectorK<N,4,true,SphereIntersector<N>>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&PointMiMBIntersectorK<N,8,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &PointMiMBIntersectorK<N,8,true,SphereIntersector<N>>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&PointMiMBIntersectorK<N,16,true,SphereIntersector<N>>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &PointMiMBIntersectorK<N,16,true,SphereIntersector<N>>::occluded;
+#endif
+      return intersectors;
+    }
+
+    template<int N>
+    static VirtualCurveIntersector::Intersectors DiscNiIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty)&PointMiIntersector1<N,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty) &PointMiIntersector1<N,true,DiscIntersector<N>>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&PointMiIntersectorK<N,4,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &PointMiIntersectorK<N,4,true,DiscIntersector<N>>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&PointMiIntersectorK<N,8,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &PointMiIntersectorK<N,8,true,DiscIntersector<N>>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&PointMiIntersectorK<N,16,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &PointMiIntersectorK<N,16,true,DiscIntersector<N>>::occluded;
+#endif
+      return intersectors;
+    }
+
+    template<int N>
+    static VirtualCurveIntersector::Intersectors DiscNiMBIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty)&PointMiMBIntersector1<N,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty) &PointMiMBIntersector1<N,true,DiscIntersector<N>>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&PointMiMBIntersectorK<N,4,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &PointMiMBIntersectorK<N,4,true,DiscIntersector<N>>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&PointMiMBIntersectorK<N,8,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &PointMiMBIntersectorK<N,8,true,DiscIntersector<N>>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&PointMiMBIntersectorK<N,16,true,DiscIntersector<N>>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &PointMiMBIntersectorK<N,16,true,DiscIntersector<N>>::occluded;
+#endif
+      return intersectors;
+    }
+
+    template<int N>
+    static VirtualCurveIntersector::Intersectors OrientedDiscNiIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty)&OrientedDiscMiIntersector1<N,true>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty) &OrientedDiscMiIntersector1<N,true>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&OrientedDiscMiIntersectorK<N,4,true>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &OrientedDiscMiIntersectorK<N,4,true>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&OrientedDiscMiIntersectorK<N,8,true>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &OrientedDiscMiIntersectorK<N,8,true>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&OrientedDiscMiIntersectorK<N,16,true>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &OrientedDiscMiIntersectorK<N,16,true>::occluded;
+#endif
+      return intersectors;
+    }
+
+    template<int N>
+    static VirtualCurveIntersector::Intersectors OrientedDiscNiMBIntersectors()
+    {
+      VirtualCurveIntersector::Intersectors intersectors;
+      intersectors.intersect1 = (VirtualCurveIntersector::Intersect1Ty)&OrientedDiscMiMBIntersector1<N,true>::intersect;
+      intersectors.occluded1  = (VirtualCurveIntersector::Occluded1Ty) &OrientedDiscMiMBIntersector1<N,true>::occluded;
+      intersectors.intersect4 = (VirtualCurveIntersector::Intersect4Ty)&OrientedDiscMiMBIntersectorK<N,4,true>::intersect;
+      intersectors.occluded4  = (VirtualCurveIntersector::Occluded4Ty) &OrientedDiscMiMBIntersectorK<N,4,true>::occluded;
+#if defined(__AVX__)
+      intersectors.intersect8 = (VirtualCurveIntersector::Intersect8Ty)&OrientedDiscMiMBIntersectorK<N,8,true>::intersect;
+      intersectors.occluded8  = (VirtualCurveIntersector::Occluded8Ty) &OrientedDiscMiMBIntersectorK<N,8,true>::occluded;
+#endif
+#if defined(__AVX512F__)
+      intersectors.intersect16 = (VirtualCurveIntersector::Intersect16Ty)&OrientedDiscMiMBIntersectorK<N,16,true>::intersect;
+      intersectors.occluded16  = (VirtualCurveIntersector::Occluded16Ty) &OrientedDiscMiMBIntersectorK<N,16,true>::occluded;
+#endif
+      return intersectors;
+    }
+
     VirtualCurveIntersector* VirtualCurveIntersector4i()
     {
       static VirtualCurveIntersector function_local_static_prim;
@@ -353,6 +468,9 @@ namespace embree
       function_local_static_prim.vtbl[Geometry::GTY_ROUND_HERMITE_CURVE] = HermiteCurveNiIntersectors <HermiteCurve3fa,4>();
       function_local_static_prim.vtbl[Geometry::GTY_FLAT_HERMITE_CURVE ] = HermiteRibbonNiIntersectors<HermiteCurve3fa,4>();
       function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_HERMITE_CURVE] = HermiteOrientedCurveNiIntersectors<HermiteCurve3fa,4>();
+      function_local_static_prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNiIntersectors<4>();
+      function_local_static_prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiIntersectors<4>();
+      function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiIntersectors<4>();
       return &function_local_static_prim;
     }
 
@@ -369,6 +487,9 @@ namespace embree
       function_local_static_prim.vtbl[Geometry::GTY_ROUND_HERMITE_CURVE] = HermiteCurveNiIntersectors <HermiteCurve3fa,4>();
       function_local_static_prim.vtbl[Geometry::GTY_FLAT_HERMITE_CURVE ] = HermiteRibbonNiIntersectors<HermiteCurve3fa,4>();
       function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_HERMITE_CURVE] = HermiteOrientedCurveNiIntersectors<HermiteCurve3fa,4>();
+      function_local_static_prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNiIntersectors<4>();
+      function_local_static_prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiIntersectors<4>();
+      function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiIntersectors<4>();
       return &function_local_static_prim;
     }
 
@@ -385,6 +506,9 @@ namespace embree
       function_local_static_prim.vtbl[Geometry::GTY_ROUND_HERMITE_CURVE] = HermiteCurveNiMBIntersectors <HermiteCurve3fa,4>();
       function_local_static_prim.vtbl[Geometry::GTY_FLAT_HERMITE_CURVE ] = HermiteRibbonNiMBIntersectors<HermiteCurve3fa,4>();
       function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_HERMITE_CURVE] = HermiteOrientedCurveNiMBIntersectors<HermiteCurve3fa,4>();
+      function_local_static_prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNiMBIntersectors<4>();
+      function_local_static_prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiMBIntersectors<4>();
+      function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiMBIntersectors<4>();
       return &function_local_static_prim;
     }
 
@@ -403,6 +527,9 @@ namespace embree
       function_local_static_prim.vtbl[Geometry::GTY_ROUND_HERMITE_CURVE] = HermiteCurveNiIntersectors <HermiteCurve3fa,8>();
       function_local_static_prim.vtbl[Geometry::GTY_FLAT_HERMITE_CURVE ] = HermiteRibbonNiIntersectors<HermiteCurve3fa,8>();
       function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_HERMITE_CURVE] = HermiteOrientedCurveNiIntersectors<HermiteCurve3fa,8>();
+      function_local_static_prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNiIntersectors<8>();
+      function_local_static_prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiIntersectors<8>();
+      function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiIntersectors<8>();
       return &function_local_static_prim;
     }
 
@@ -419,6 +546,9 @@ namespace embree
       function_local_static_prim.vtbl[Geometry::GTY_ROUND_HERMITE_CURVE] = HermiteCurveNiIntersectors <HermiteCurve3fa,8>();
       function_local_static_prim.vtbl[Geometry::GTY_FLAT_HERMITE_CURVE ] = HermiteRibbonNiIntersectors<HermiteCurve3fa,8>();
       function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_HERMITE_CURVE] = HermiteOrientedCurveNiIntersectors<HermiteCurve3fa,8>();
+      function_local_static_prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNiIntersectors<8>();
+      function_local_static_prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiIntersectors<8>();
+      function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiIntersectors<8>();
       return &function_local_static_prim;
     }
     
@@ -435,6 +565,9 @@ namespace embree
       function_local_static_prim.vtbl[Geometry::GTY_ROUND_HERMITE_CURVE] = HermiteCurveNiMBIntersectors <HermiteCurve3fa,8>();
       function_local_static_prim.vtbl[Geometry::GTY_FLAT_HERMITE_CURVE ] = HermiteRibbonNiMBIntersectors<HermiteCurve3fa,8>();
       function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_HERMITE_CURVE] = HermiteOrientedCurveNiMBIntersectors<HermiteCurve3fa,8>();
+      function_local_static_prim.vtbl[Geometry::GTY_SPHERE_POINT] = SphereNiMBIntersectors<8>();
+      function_local_static_prim.vtbl[Geometry::GTY_DISC_POINT] = DiscNiMBIntersectors<8>();
+      function_local_static_prim.vtbl[Geometry::GTY_ORIENTED_DISC_POINT] = OrientedDiscNiMBIntersectors<8>();
       return &function_local_static_prim;
     }
   
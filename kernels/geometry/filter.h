@@ -25,11 +25,26 @@ namespace embree
 {
   namespace isa
   {
+    /*! passes the accepted hits to the hit collectors of a multi-hit query, the hit
+     *  distance is taken from the ray's tfar and replaced by the collector's far distance */
+    __forceinline void collectHits(const RTCFilterFunctionNArguments* args, IntersectContext* context)
+    {
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] == 0) continue;
+        HitCollector& collector = context->collector[i];
+        float& tfar = RTCRayN_tfar(args->ray,args->N,i);
+        collector.insert(tfar,args->hit,args->N,i);
+        tfar = collector.tfar;
+      }
+    }
+    
     __forceinline bool runIntersectionFilter1Helper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, IntersectContext* context)
     {
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(filter_calls,1);
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -38,11 +53,18 @@ namespace embree
             
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(filter_calls,1);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
           return false;
       }
+
+      /* collected hits shorten the ray but are not committed */
+      if (unlikely(context->collector != nullptr)) {
+        collectHits(args,context);
+        return true;
+      }
       
       copyHitToRay(*(RayHit*)args->ray,*(Hit*)args->hit);
       return true;
@@ -68,6 +90,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->intersectionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(filter_calls,1);
         geometry->intersectionFilterN(filter_args);
       }
       
@@ -76,8 +99,16 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(filter_calls,1);
         context->user->filter(filter_args);
       }
+
+      /* user geometries commit accepted hits themselves, thus collected hits get rejected */
+      if (unlikely(context->collector != nullptr)) {
+        collectHits(filter_args,context);
+        for (unsigned int i=0; i<filter_args->N; i++)
+          filter_args->valid[i] = 0;
+      }
 #endif
     }
     
@@ -86,6 +117,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(filter_calls,1);
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -94,6 +126,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(filter_calls,1);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -122,6 +155,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->occlusionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(filter_calls,1);
         geometry->occlusionFilterN(filter_args);
       }
       
@@ -130,6 +164,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(filter_calls,1);
         context->user->filter(filter_args);
       }
 #endif
@@ -142,6 +177,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(filter_calls,1);
         geometry->intersectionFilterN(args);
       }
 
@@ -150,11 +186,18 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(filter_calls,1);
         context->user->filter(args);
       }
 
       valid_o = *mask != vint<K>(zero);
       if (none(valid_o)) return valid_o;
+
+      /* collected hits shorten the rays but are not committed */
+      if (unlikely(context->collector != nullptr)) {
+        collectHits(args,context);
+        return valid_o;
+      }
       
       copyHitToRay(valid_o,*(RayHitK<K>*)args->ray,*(HitK<K>*)args->hit);
       return valid_o;
@@ -181,6 +224,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        TRAV_STAT(filter_calls,1);
         geometry->occlusionFilterN(args);
       }
 
@@ -190,6 +234,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        TRAV_STAT(filter_calls,1);
         context->user->filter(args);
       }
 
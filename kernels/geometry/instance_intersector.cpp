@@ -37,10 +37,12 @@ namespace embree
       const Vec3fa ray_dir = ray.dir;
       ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
       ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context,context->collector);
+        instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -61,10 +63,12 @@ namespace embree
       const Vec3fa ray_dir = ray.dir;
       ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
       ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
       return ray.tfar < 0.0f;
@@ -86,10 +90,12 @@ namespace embree
       const Vec3fa ray_dir = ray.dir;
       ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
       ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context,context->collector);
+        instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -110,10 +116,12 @@ namespace embree
       const Vec3fa ray_dir = ray.dir;
       ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
       ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
       return ray.tfar < 0.0f;
@@ -137,10 +145,12 @@ namespace embree
       const Vec3vf<K> ray_dir = ray.dir;
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context,context->collector);
+        instance->object->intersectors.intersect(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -163,10 +173,12 @@ namespace embree
       const Vec3vf<K> ray_dir = ray.dir;
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
       return ray.tfar < 0.0f;
@@ -190,10 +202,12 @@ namespace embree
       const Vec3vf<K> ray_dir = ray.dir;
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context,context->collector);
+        instance->object->intersectors.intersect(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
     }
@@ -216,10 +230,12 @@ namespace embree
       const Vec3vf<K> ray_dir = ray.dir;
       ray.org = xfmPoint (world2local,ray_org);
       ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded(valid,ray,&newcontext);
+        instance_id_stack::pop(user_context);
+      }
       ray.org = ray_org;
       ray.dir = ray_dir;
       return ray.tfar < 0.0f;
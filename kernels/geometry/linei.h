@@ -30,6 +30,8 @@ namespace embree
       size_t sizeActive(const char* This) const;
       size_t sizeTotal(const char* This) const;
       size_t getBytes(const char* This) const;      
+      unsigned int getGeomID(const char* This, size_t i) const;
+      unsigned int getPrimID(const char* This, size_t i) const;
     };
     static Type type;
 
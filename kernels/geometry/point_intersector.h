@@ -0,0 +1,153 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "../common/ray.h"
+#include "curve_intersector_precalculations.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct PointIntersectorHitM
+      {
+        __forceinline PointIntersectorHitM() {}
+
+        __forceinline PointIntersectorHitM(const vfloat<M>& t, const Vec3vf<M>& Ng)
+          : vu(zero), vv(zero), vt(t), vNg(Ng) {}
+
+        __forceinline void finalize() {}
+
+        __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+        __forceinline float t  (const size_t i) const { return vt[i]; }
+        __forceinline Vec3fa Ng(const size_t i) const { return Vec3fa(vNg.x[i],vNg.y[i],vNg.z[i]); }
+
+      public:
+        vfloat<M> vu;
+        vfloat<M> vv;
+        vfloat<M> vt;
+        Vec3vf<M> vNg;
+      };
+
+    /*! intersects a ray with M spheres given as center and radius */
+    template<int M>
+      struct SphereIntersector
+      {
+        template<typename Epilog>
+        static __forceinline bool intersect(const vbool<M>& valid_i,
+                                            const Vec3vf<M>& ray_org, const Vec3vf<M>& ray_dir,
+                                            const vfloat<M>& ray_tnear, const vfloat<M>& ray_tfar,
+                                            const Vec4vf<M>& v0,
+                                            const Epilog& epilog)
+        {
+          vbool<M> valid = valid_i;
+          const Vec3vf<M> center_rel = v0.xyz()-ray_org;
+          const vfloat<M> radius = v0.w;
+
+          /* solve quadratic equation |org+t*dir-center|^2 = radius^2 */
+          const vfloat<M> A = dot(ray_dir,ray_dir);
+          const vfloat<M> B = dot(center_rel,ray_dir);
+          const vfloat<M> C = dot(center_rel,center_rel)-radius*radius;
+          const vfloat<M> D = B*B-A*C;
+          valid &= D >= 0.0f;
+          if (unlikely(none(valid))) return false;
+
+          /* take the front hit, or the back hit if the ray starts inside the sphere */
+          const vfloat<M> Q = sqrt(D);
+          const vfloat<M> rcp_A = rcp(A);
+          const vfloat<M> t_front = (B-Q)*rcp_A;
+          const vfloat<M> t_back  = (B+Q)*rcp_A;
+          const vbool<M> valid_front = valid & (ray_tnear < t_front) & (t_front <= ray_tfar);
+          const vbool<M> valid_back  = valid & (ray_tnear < t_back ) & (t_back  <= ray_tfar);
+          valid = valid_front | valid_back;
+          if (unlikely(none(valid))) return false;
+
+          /* update hit information */
+          const vfloat<M> t = select(valid_front,t_front,t_back);
+          const Vec3vf<M> Ng = t*ray_dir-center_rel;
+          PointIntersectorHitM<M> hit(t,Ng);
+          return epilog(valid,hit);
+        }
+      };
+
+    /*! intersects a ray with M discs that face the ray origin */
+    template<int M>
+      struct DiscIntersector
+      {
+        template<typename Epilog>
+        static __forceinline bool intersect(const vbool<M>& valid_i,
+                                            const Vec3vf<M>& ray_org, const Vec3vf<M>& ray_dir,
+                                            const vfloat<M>& ray_tnear, const vfloat<M>& ray_tfar,
+                                            const Vec4vf<M>& v0,
+                                            const Epilog& epilog)
+        {
+          vbool<M> valid = valid_i;
+          const Vec3vf<M> center_rel = v0.xyz()-ray_org;
+          const vfloat<M> radius = v0.w;
+
+          /* intersect with plane through center orthogonal to ray direction */
+          const vfloat<M> t = dot(center_rel,ray_dir)*rcp(dot(ray_dir,ray_dir));
+          valid &= (ray_tnear < t) & (t <= ray_tfar);
+          if (unlikely(none(valid))) return false;
+
+          const Vec3vf<M> p = t*ray_dir-center_rel;
+          valid &= dot(p,p) <= radius*radius;
+          if (unlikely(none(valid))) return false;
+
+          /* update hit information */
+          PointIntersectorHitM<M> hit(t,-ray_dir);
+          return epilog(valid,hit);
+        }
+      };
+
+    /*! intersects a ray with M discs oriented along the normals n0 */
+    template<int M>
+      struct OrientedDiscIntersector
+      {
+        template<typename Epilog>
+        static __forceinline bool intersect(const vbool<M>& valid_i,
+                                            const Vec3vf<M>& ray_org, const Vec3vf<M>& ray_dir,
+                                            const vfloat<M>& ray_tnear, const vfloat<M>& ray_tfar,
+                                            const Vec4vf<M>& v0, const Vec3vf<M>& n0,
+                                            const Epilog& epilog)
+        {
+          vbool<M> valid = valid_i;
+          const Vec3vf<M> center_rel = v0.xyz()-ray_org;
+          const vfloat<M> radius = v0.w;
+
+          /* intersect with plane through center orthogonal to normal */
+          const vfloat<M> dn = dot(ray_dir,n0);
+          valid &= dn != vfloat<M>(zero);
+          if (unlikely(none(valid))) return false;
+
+          const vfloat<M> t = dot(center_rel,n0)*rcp(dn);
+          valid &= (ray_tnear < t) & (t <= ray_tfar);
+          if (unlikely(none(valid))) return false;
+
+          const Vec3vf<M> p = t*ray_dir-center_rel;
+          valid &= dot(p,p) <= radius*radius;
+          if (unlikely(none(valid))) return false;
+
+          /* update hit information */
+          PointIntersectorHitM<M> hit(t,n0);
+          return epilog(valid,hit);
+        }
+      };
+  }
+}
@@ -0,0 +1,382 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  template<int M>
+  struct PointMi
+  {
+    /* Virtual interface to query information about the point type */
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+      unsigned int getGeomID(const char* This, size_t i) const;
+      unsigned int getPrimID(const char* This, size_t i) const;
+    };
+    static Type type;
+
+  public:
+
+    /* primitive supports multiple time segments */
+    static const bool singleTimeSegment = false;
+
+    /* Returns maximum number of stored points */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N points */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns required number of bytes for N points */
+    static __forceinline size_t bytes(size_t N) { return blocks(N)*sizeof(PointMi); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline PointMi() {  }
+
+    /* Construction from IDs, invalid slots replicate the last valid point */
+    __forceinline PointMi(const vuint<M>& geomIDs, const vuint<M>& primIDs, size_t m, Geometry::GType gtype)
+      : gtype((unsigned char)gtype), m((unsigned char)m), sharedGeomID(geomIDs[0]), primIDs(primIDs)
+    {
+      assert(all(vuint<M>(geomID()) == geomIDs));
+    }
+
+    /* Returns a mask that tells which points are valid */
+    __forceinline vbool<M> valid() const { return vint<M>(step) < vint<M>(int(m)); }
+
+    /* Returns a mask that tells which points are valid */
+    template<int Mx>
+    __forceinline vbool<Mx> valid() const { return vint<Mx>(step) < vint<Mx>(int(m)); }
+
+    /* Returns if the specified point is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return i<m; }
+
+    /* Returns the number of stored points */
+    __forceinline size_t size() const { return m; }
+
+    /* Returns the geometry ID */
+    __forceinline unsigned int geomID(unsigned int i = 0) const { return sharedGeomID; }
+
+    /* Returns the primitive IDs, which are also the vertex indices */
+    __forceinline       vuint<M>& primID()       { return primIDs; }
+    __forceinline const vuint<M>& primID() const { return primIDs; }
+    __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* gather the points */
+    __forceinline void gather(Vec4vf<M>& p0,
+                              const Points* geom) const;
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              Vec3vf<M>& n0,
+                              const Points* geom) const;
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              const Points* geom,
+                              const vint<M>& itime) const;
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              Vec3vf<M>& n0,
+                              const Points* geom,
+                              const vint<M>& itime) const;
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              const Scene* scene) const
+    {
+      gather(p0,scene->get<Points>(geomID()));
+    }
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              Vec3vf<M>& n0,
+                              const Scene* scene) const
+    {
+      gather(p0,n0,scene->get<Points>(geomID()));
+    }
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              const Scene* scene,
+                              float time) const
+    {
+      const Points* geom = scene->get<Points>(geomID());
+      const vfloat<M> numTimeSegments(geom->fnumTimeSegments);
+      vfloat<M> ftime;
+      const vint<M> itime = getTimeSegment(vfloat<M>(time), numTimeSegments, ftime);
+
+      Vec4vf<M> a0; gather(a0,geom,itime);
+      Vec4vf<M> b0; gather(b0,geom,itime+1);
+      p0 = lerp(a0,b0,ftime);
+    }
+
+    __forceinline void gather(Vec4vf<M>& p0,
+                              Vec3vf<M>& n0,
+                              const Scene* scene,
+                              float time) const
+    {
+      const Points* geom = scene->get<Points>(geomID());
+      const vfloat<M> numTimeSegments(geom->fnumTimeSegments);
+      vfloat<M> ftime;
+      const vint<M> itime = getTimeSegment(vfloat<M>(time), numTimeSegments, ftime);
+
+      Vec4vf<M> a0; Vec3vf<M> an; gather(a0,an,geom,itime);
+      Vec4vf<M> b0; Vec3vf<M> bn; gather(b0,bn,geom,itime+1);
+      p0 = lerp(a0,b0,ftime);
+      n0 = lerp(an,bn,ftime);
+    }
+
+    /* Calculate the bounds of the points */
+    __forceinline const BBox3fa bounds(const Scene* scene, size_t itime = 0) const
+    {
+      BBox3fa bounds = empty;
+      const Points* geom = scene->get<Points>(geomID());
+      for (size_t i=0; i<M && valid(i); i++)
+        bounds.extend(geom->bounds(primID(i),itime));
+      return bounds;
+    }
+
+    /* Calculate the linear bounds of the primitive */
+    __forceinline LBBox3fa linearBounds(const Scene* scene, size_t itime) {
+      return LBBox3fa(bounds(scene,itime+0), bounds(scene,itime+1));
+    }
+
+    __forceinline LBBox3fa linearBounds(const Scene *const scene, const BBox1f time_range)
+    {
+      LBBox3fa allBounds = empty;
+      const Points* geom = scene->get<Points>(geomID());
+      for (size_t i=0; i<M && valid(i); i++)
+        allBounds.extend(geom->linearBounds(primID(i), time_range));
+      return allBounds;
+    }
+
+    /* Fill point from point list */
+    template<typename PrimRefT>
+    __forceinline void fill(const PrimRefT* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      Geometry::GType gty = scene->get(prims[begin].geomID())->getType();
+      vuint<M> geomID, primID;
+      size_t m = 0;
+
+      for (size_t i=0; i<M; i++)
+      {
+        if (begin<end) {
+          geomID[i] = prims[begin].geomID();
+          primID[i] = prims[begin].primID();
+          begin++; m++;
+        } else {
+          assert(i);
+          geomID[i] = geomID[i-1];
+          primID[i] = primID[i-1];
+        }
+      }
+      new (this) PointMi(geomID,primID,m,gty); // FIXME: use non temporal store
+    }
+
+    template<typename BVH, typename Allocator>
+    __forceinline static typename BVH::NodeRef createLeaf (BVH* bvh, const PrimRef* prims, const range<size_t>& set, const Allocator& alloc)
+    {
+      size_t start = set.begin();
+      size_t items = PointMi::blocks(set.size());
+      size_t numbytes = PointMi::bytes(set.size());
+      PointMi* accel = (PointMi*) alloc.malloc1(numbytes,M*sizeof(float));
+      for (size_t i=0; i<items; i++) {
+        accel[i].fill(prims,start,set.end(),bvh->scene);
+      }
+      return bvh->encodeLeaf((char*)accel,items);
+    };
+
+    __forceinline LBBox3fa fillMB(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, size_t itime)
+    {
+      fill(prims,begin,end,scene);
+      return linearBounds(scene,itime);
+    }
+
+    __forceinline LBBox3fa fillMB(const PrimRefMB* prims, size_t& begin, size_t end, Scene* scene, const BBox1f time_range)
+    {
+      fill(prims,begin,end,scene);
+      return linearBounds(scene,time_range);
+    }
+
+    template<typename BVH, typename SetMB, typename Allocator>
+    __forceinline static typename BVH::NodeRecordMB4D createLeafMB(BVH* bvh, const SetMB& prims, const Allocator& alloc)
+    {
+      size_t start = prims.object_range.begin();
+      size_t end   = prims.object_range.end();
+      size_t items = PointMi::blocks(prims.object_range.size());
+      size_t numbytes = PointMi::bytes(prims.object_range.size());
+      PointMi* accel = (PointMi*) alloc.malloc1(numbytes,M*sizeof(float));
+      const typename BVH::NodeRef node = bvh->encodeLeaf((char*)accel,items);
+
+      LBBox3fa bounds = empty;
+      for (size_t i=0; i<items; i++)
+        bounds.extend(accel[i].fillMB(prims.prims->data(),start,end,bvh->scene,prims.time_range));
+
+      return typename BVH::NodeRecordMB4D(node,bounds,prims.time_range);
+    };
+
+    /* Updates the primitive */
+    __forceinline BBox3fa update(Points* geom)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+        bounds.extend(geom->bounds(primID(i)));
+      return bounds;
+    }
+
+    /*! output operator */
+    friend __forceinline std::ostream& operator<<(std::ostream& cout, const PointMi& point) {
+      return cout << "Point" << M << "i {" << point.geomID() << ", " << point.primID() << "}";
+    }
+
+  public:
+    unsigned char gtype;
+    unsigned char m;
+    unsigned int sharedGeomID;
+  private:
+    vuint<M> primIDs; // primitive ID
+  };
+
+  template<>
+  __forceinline void PointMi<4>::gather(Vec4vf4& p0,
+                                        const Points* geom) const
+  {
+    const vfloat4 a0 = vfloat4::loadu(geom->vertexPtr(primID(0)));
+    const vfloat4 a1 = vfloat4::loadu(geom->vertexPtr(primID(1)));
+    const vfloat4 a2 = vfloat4::loadu(geom->vertexPtr(primID(2)));
+    const vfloat4 a3 = vfloat4::loadu(geom->vertexPtr(primID(3)));
+    transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z,p0.w);
+  }
+
+  template<>
+  __forceinline void PointMi<4>::gather(Vec4vf4& p0,
+                                        Vec3vf4& n0,
+                                        const Points* geom) const
+  {
+    gather(p0,geom);
+    const vfloat4 b0 = vfloat4::loadu(geom->normalPtr(primID(0)));
+    const vfloat4 b1 = vfloat4::loadu(geom->normalPtr(primID(1)));
+    const vfloat4 b2 = vfloat4::loadu(geom->normalPtr(primID(2)));
+    const vfloat4 b3 = vfloat4::loadu(geom->normalPtr(primID(3)));
+    transpose(b0,b1,b2,b3,n0.x,n0.y,n0.z);
+  }
+
+  template<>
+  __forceinline void PointMi<4>::gather(Vec4vf4& p0,
+                                        const Points* geom,
+                                        const vint4& itime) const
+  {
+    const vfloat4 a0 = vfloat4::loadu(geom->vertexPtr(primID(0),itime[0]));
+    const vfloat4 a1 = vfloat4::loadu(geom->vertexPtr(primID(1),itime[1]));
+    const vfloat4 a2 = vfloat4::loadu(geom->vertexPtr(primID(2),itime[2]));
+    const vfloat4 a3 = vfloat4::loadu(geom->vertexPtr(primID(3),itime[3]));
+    transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z,p0.w);
+  }
+
+  template<>
+  __forceinline void PointMi<4>::gather(Vec4vf4& p0,
+                                        Vec3vf4& n0,
+                                        const Points* geom,
+                                        const vint4& itime) const
+  {
+    gather(p0,geom,itime);
+    const vfloat4 b0 = vfloat4::loadu(geom->normalPtr(primID(0),itime[0]));
+    const vfloat4 b1 = vfloat4::loadu(geom->normalPtr(primID(1),itime[1]));
+    const vfloat4 b2 = vfloat4::loadu(geom->normalPtr(primID(2),itime[2]));
+    const vfloat4 b3 = vfloat4::loadu(geom->normalPtr(primID(3),itime[3]));
+    transpose(b0,b1,b2,b3,n0.x,n0.y,n0.z);
+  }
+
+#if defined(__AVX__)
+
+  template<>
+  __forceinline void PointMi<8>::gather(Vec4vf8& p0,
+                                        const Points* geom) const
+  {
+    const vfloat4 a0 = vfloat4::loadu(geom->vertexPtr(primID(0)));
+    const vfloat4 a1 = vfloat4::loadu(geom->vertexPtr(primID(1)));
+    const vfloat4 a2 = vfloat4::loadu(geom->vertexPtr(primID(2)));
+    const vfloat4 a3 = vfloat4::loadu(geom->vertexPtr(primID(3)));
+    const vfloat4 a4 = vfloat4::loadu(geom->vertexPtr(primID(4)));
+    const vfloat4 a5 = vfloat4::loadu(geom->vertexPtr(primID(5)));
+    const vfloat4 a6 = vfloat4::loadu(geom->vertexPtr(primID(6)));
+    const vfloat4 a7 = vfloat4::loadu(geom->vertexPtr(primID(7)));
+    transpose(a0,a1,a2,a3,a4,a5,a6,a7,p0.x,p0.y,p0.z,p0.w);
+  }
+
+  template<>
+  __forceinline void PointMi<8>::gather(Vec4vf8& p0,
+                                        Vec3vf8& n0,
+                                        const Points* geom) const
+  {
+    gather(p0,geom);
+    const vfloat4 b0 = vfloat4::loadu(geom->normalPtr(primID(0)));
+    const vfloat4 b1 = vfloat4::loadu(geom->normalPtr(primID(1)));
+    const vfloat4 b2 = vfloat4::loadu(geom->normalPtr(primID(2)));
+    const vfloat4 b3 = vfloat4::loadu(geom->normalPtr(primID(3)));
+    const vfloat4 b4 = vfloat4::loadu(geom->normalPtr(primID(4)));
+    const vfloat4 b5 = vfloat4::loadu(geom->normalPtr(primID(5)));
+    const vfloat4 b6 = vfloat4::loadu(geom->normalPtr(primID(6)));
+    const vfloat4 b7 = vfloat4::loadu(geom->normalPtr(primID(7)));
+    transpose(b0,b1,b2,b3,b4,b5,b6,b7,n0.x,n0.y,n0.z);
+  }
+
+  template<>
+  __forceinline void PointMi<8>::gather(Vec4vf8& p0,
+                                        const Points* geom,
+                                        const vint8& itime) const
+  {
+    const vfloat4 a0 = vfloat4::loadu(geom->vertexPtr(primID(0),itime[0]));
+    const vfloat4 a1 = vfloat4::loadu(geom->vertexPtr(primID(1),itime[1]));
+    const vfloat4 a2 = vfloat4::loadu(geom->vertexPtr(primID(2),itime[2]));
+    const vfloat4 a3 = vfloat4::loadu(geom->vertexPtr(primID(3),itime[3]));
+    const vfloat4 a4 = vfloat4::loadu(geom->vertexPtr(primID(4),itime[4]));
+    const vfloat4 a5 = vfloat4::loadu(geom->vertexPtr(primID(5),itime[5]));
+    const vfloat4 a6 = vfloat4::loadu(geom->vertexPtr(primID(6),itime[6]));
+    const vfloat4 a7 = vfloat4::loadu(geom->vertexPtr(primID(7),itime[7]));
+    transpose(a0,a1,a2,a3,a4,a5,a6,a7,p0.x,p0.y,p0.z,p0.w);
+  }
+
+  template<>
+  __forceinline void PointMi<8>::gather(Vec4vf8& p0,
+                                        Vec3vf8& n0,
+                                        const Points* geom,
+                                        const vint8& itime) const
+  {
+    gather(p0,geom,itime);
+    const vfloat4 b0 = vfloat4::loadu(geom->normalPtr(primID(0),itime[0]));
+    const vfloat4 b1 = vfloat4::loadu(geom->normalPtr(primID(1),itime[1]));
+    const vfloat4 b2 = vfloat4::loadu(geom->normalPtr(primID(2),itime[2]));
+    const vfloat4 b3 = vfloat4::loadu(geom->normalPtr(primID(3),itime[3]));
+    const vfloat4 b4 = vfloat4::loadu(geom->normalPtr(primID(4),itime[4]));
+    const vfloat4 b5 = vfloat4::loadu(geom->normalPtr(primID(5),itime[5]));
+    const vfloat4 b6 = vfloat4::loadu(geom->normalPtr(primID(6),itime[6]));
+    const vfloat4 b7 = vfloat4::loadu(geom->normalPtr(primID(7),itime[7]));
+    transpose(b0,b1,b2,b3,b4,b5,b6,b7,n0.x,n0.y,n0.z);
+  }
+
+#endif
+
+  template<int M>
+  typename PointMi<M>::Type PointMi<M>::type;
+
+  typedef PointMi<4> Point4i;
+  typedef PointMi<8> Point8i;
+}
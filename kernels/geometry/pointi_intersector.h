@@ -0,0 +1,230 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "pointi.h"
+#include "point_intersector.h"
+#include "intersector_epilog.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! intersects spheres and ray facing discs */
+    template<int M, bool filter, typename Intersector>
+    struct PointMiIntersector1
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene);
+        Intersector::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,
+                               Intersect1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene);
+        return Intersector::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,
+                                      Occluded1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+    };
+
+    template<int M, bool filter, typename Intersector>
+    struct PointMiMBIntersector1
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene,ray.time());
+        Intersector::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,
+                               Intersect1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene,ray.time());
+        return Intersector::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,
+                                      Occluded1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+    };
+
+    template<int M, int K, bool filter, typename Intersector>
+    struct PointMiIntersectorK
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        Intersector::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,
+                               Intersect1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        return Intersector::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,
+                                      Occluded1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+    };
+
+    template<int M, int K, bool filter, typename Intersector>
+    struct PointMiMBIntersectorK
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene,ray.time()[k]);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        Intersector::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,
+                               Intersect1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; point.gather(v0,context->scene,ray.time()[k]);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        return Intersector::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,
+                                      Occluded1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+    };
+
+    /*! intersects discs oriented along a per point normal */
+    template<int M, bool filter>
+    struct OrientedDiscMiIntersector1
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene);
+        OrientedDiscIntersector<M>::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,n0,
+                                              Intersect1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene);
+        return OrientedDiscIntersector<M>::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,n0,
+                                                     Occluded1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+    };
+
+    template<int M, bool filter>
+    struct OrientedDiscMiMBIntersector1
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculations1 Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene,ray.time());
+        OrientedDiscIntersector<M>::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,n0,
+                                              Intersect1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene,ray.time());
+        return OrientedDiscIntersector<M>::intersect(point.valid(),Vec3vf<M>(ray.org),Vec3vf<M>(ray.dir),vfloat<M>(ray.tnear()),vfloat<M>(ray.tfar),v0,n0,
+                                                     Occluded1EpilogM<M,M,filter>(ray,context,point.geomID(),point.primID()));
+      }
+    };
+
+    template<int M, int K, bool filter>
+    struct OrientedDiscMiIntersectorK
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        OrientedDiscIntersector<M>::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,n0,
+                                              Intersect1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        return OrientedDiscIntersector<M>::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,n0,
+                                                     Occluded1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+    };
+
+    template<int M, int K, bool filter>
+    struct OrientedDiscMiMBIntersectorK
+    {
+      typedef PointMi<M> Primitive;
+      typedef CurvePrecalculationsK<K> Precalculations;
+
+      static __forceinline void intersect(const Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene,ray.time()[k]);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        OrientedDiscIntersector<M>::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,n0,
+                                              Intersect1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+
+      static __forceinline bool occluded(const Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive& point)
+      {
+        STAT3(shadow.trav_prims,1,1,1);
+        Vec4vf<M> v0; Vec3vf<M> n0; point.gather(v0,n0,context->scene,ray.time()[k]);
+        const Vec3vf<M> ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        const Vec3vf<M> ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+        return OrientedDiscIntersector<M>::intersect(point.valid(),ray_org,ray_dir,vfloat<M>(ray.tnear()[k]),vfloat<M>(ray.tfar[k]),v0,n0,
+                                                     Occluded1KEpilogM<M,M,K,filter>(ray,k,context,point.geomID(),point.primID()));
+      }
+    };
+  }
+}
@@ -37,5 +37,11 @@ namespace embree
 
     /*! Returns the number of bytes of block. */
     virtual size_t getBytes(const char* This) const = 0;
+
+    /*! Returns the geometry ID of the i'th active primitive of a block. */
+    virtual unsigned int getGeomID(const char* This, size_t i) const = 0;
+
+    /*! Returns the primitive ID of the i'th active primitive of a block. */
+    virtual unsigned int getPrimID(const char* This, size_t i) const = 0;
   };
 }
@@ -19,6 +19,7 @@
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
+#include "pointi.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
@@ -42,7 +43,9 @@ namespace embree
   template<>
   size_t Curve4v::Type::sizeActive(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->size();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return ((Line4i*)This)->size();
     else
       return ((Curve4v*)This)->N;
@@ -51,7 +54,9 @@ namespace embree
   template<>
   size_t Curve4v::Type::sizeTotal(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return 4;
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return 4;
     else
       return ((Curve4v*)This)->N;
@@ -60,12 +65,34 @@ namespace embree
   template<>
   size_t Curve4v::Type::getBytes(const char* This) const
   {
-     if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+     if ((1 << *This) & Geometry::MTY_POINTS)
+       return Point4i::bytes(sizeActive(This));
+     else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
        return Line4i::bytes(sizeActive(This));
      else
        return Curve4v::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve4v::Type::getGeomID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->geomID();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->geomID();
+    else
+      return ((Curve4v*)This)->geomID(((Curve4v*)This)->N);
+  }
+
+  template<>
+  unsigned int Curve4v::Type::getPrimID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->primID(i);
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->primID(i);
+    else
+      return ((Curve4v*)This)->primID(((Curve4v*)This)->N)[i];
+  }
+
   /********************** Curve4i **************************/
 
   template<>
@@ -76,7 +103,9 @@ namespace embree
   template<>
   size_t Curve4i::Type::sizeActive(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->size();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return ((Line4i*)This)->size();
     else
       return ((Curve4i*)This)->N;
@@ -85,7 +114,9 @@ namespace embree
   template<>
   size_t Curve4i::Type::sizeTotal(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return 4;
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return 4;
     else
       return ((Curve4i*)This)->N;
@@ -94,12 +125,34 @@ namespace embree
   template<>
   size_t Curve4i::Type::getBytes(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+       return Point4i::bytes(sizeActive(This));
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
        return Line4i::bytes(sizeActive(This));
      else
        return Curve4i::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve4i::Type::getGeomID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->geomID();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->geomID();
+    else
+      return ((Curve4i*)This)->geomID(((Curve4i*)This)->N);
+  }
+
+  template<>
+  unsigned int Curve4i::Type::getPrimID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->primID(i);
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->primID(i);
+    else
+      return ((Curve4i*)This)->primID(((Curve4i*)This)->N)[i];
+  }
+
   /********************** Curve4iMB **************************/
 
   template<>
@@ -110,7 +163,9 @@ namespace embree
   template<>
   size_t Curve4iMB::Type::sizeActive(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->size();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return ((Line4i*)This)->size();
     else
       return ((Curve4iMB*)This)->N;
@@ -119,7 +174,9 @@ namespace embree
   template<>
   size_t Curve4iMB::Type::sizeTotal(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return 4;
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return 4;
     else
       return ((Curve4iMB*)This)->N;
@@ -128,12 +185,34 @@ namespace embree
   template<>
   size_t Curve4iMB::Type::getBytes(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+       return Point4i::bytes(sizeActive(This));
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
        return Line4i::bytes(sizeActive(This));
      else
        return Curve4iMB::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve4iMB::Type::getGeomID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->geomID();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->geomID();
+    else
+      return ((Curve4iMB*)This)->geomID(((Curve4iMB*)This)->N);
+  }
+
+  template<>
+  unsigned int Curve4iMB::Type::getPrimID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point4i*)This)->primID(i);
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->primID(i);
+    else
+      return ((Curve4iMB*)This)->primID(((Curve4iMB*)This)->N)[i];
+  }
+
   /********************** Line4i **************************/
 
   template<>
@@ -156,6 +235,48 @@ namespace embree
     return sizeof(Line4i);
   }
 
+  template<>
+  unsigned int Line4i::Type::getGeomID(const char* This, size_t i) const {
+    return ((Line4i*)This)->geomID();
+  }
+
+  template<>
+  unsigned int Line4i::Type::getPrimID(const char* This, size_t i) const {
+    return ((Line4i*)This)->primID(i);
+  }
+
+  /********************** Point4i **************************/
+
+  template<>
+  const char* Point4i::Type::name () const {
+    return "point4i";
+  }
+
+  template<>
+  size_t Point4i::Type::sizeActive(const char* This) const {
+    return ((Point4i*)This)->size();
+  }
+
+  template<>
+  size_t Point4i::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Point4i::Type::getBytes(const char* This) const {
+    return sizeof(Point4i);
+  }
+
+  template<>
+  unsigned int Point4i::Type::getGeomID(const char* This, size_t i) const {
+    return ((Point4i*)This)->geomID();
+  }
+
+  template<>
+  unsigned int Point4i::Type::getPrimID(const char* This, size_t i) const {
+    return ((Point4i*)This)->primID(i);
+  }
+
   /********************** Triangle4 **************************/
 
   template<>
@@ -178,6 +299,16 @@ namespace embree
     return sizeof(Triangle4);
   }
 
+  template<>
+  unsigned int Triangle4::Type::getGeomID(const char* This, size_t i) const {
+    return ((Triangle4*)This)->geomID(i);
+  }
+
+  template<>
+  unsigned int Triangle4::Type::getPrimID(const char* This, size_t i) const {
+    return ((Triangle4*)This)->primID(i);
+  }
+
   /********************** Triangle4v **************************/
 
   template<>
@@ -200,6 +331,16 @@ namespace embree
     return sizeof(Triangle4v);
   }
 
+  template<>
+  unsigned int Triangle4v::Type::getGeomID(const char* This, size_t i) const {
+    return ((Triangle4v*)This)->geomID(i);
+  }
+
+  template<>
+  unsigned int Triangle4v::Type::getPrimID(const char* This, size_t i) const {
+    return ((Triangle4v*)This)->primID(i);
+  }
+
   /********************** Triangle4i **************************/
 
   template<>
@@ -222,6 +363,16 @@ namespace embree
     return sizeof(Triangle4i);
   }
 
+  template<>
+  unsigned int Triangle4i::Type::getGeomID(const char* This, size_t i) const {
+    return ((Triangle4i*)This)->geomID(i);
+  }
+
+  template<>
+  unsigned int Triangle4i::Type::getPrimID(const char* This, size_t i) const {
+    return ((Triangle4i*)This)->primID(i);
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -244,6 +395,16 @@ namespace embree
     return sizeof(Triangle4vMB);
   }
 
+  template<>
+  unsigned int Triangle4vMB::Type::getGeomID(const char* This, size_t i) const {
+    return ((Triangle4vMB*)This)->geomID(i);
+  }
+
+  template<>
+  unsigned int Triangle4vMB::Type::getPrimID(const char* This, size_t i) const {
+    return ((Triangle4vMB*)This)->primID(i);
+  }
+
   /********************** Quad4v **************************/
 
   template<>
@@ -266,6 +427,16 @@ namespace embree
     return sizeof(Quad4v);
   }
 
+  template<>
+  unsigned int Quad4v::Type::getGeomID(const char* This, size_t i) const {
+    return ((Quad4v*)This)->geomID(i);
+  }
+
+  template<>
+  unsigned int Quad4v::Type::getPrimID(const char* This, size_t i) const {
+    return ((Quad4v*)This)->primID(i);
+  }
+
   /********************** Quad4i **************************/
 
   template<>
@@ -288,6 +459,16 @@ namespace embree
     return sizeof(Quad4i);
   }
 
+  template<>
+  unsigned int Quad4i::Type::getGeomID(const char* This, size_t i) const {
+    return ((Quad4i*)This)->geomID(i);
+  }
+
+  template<>
+  unsigned int Quad4i::Type::getPrimID(const char* This, size_t i) const {
+    return ((Quad4i*)This)->primID(i);
+  }
+
   /********************** SubdivPatch1 **************************/
 
   const char* SubdivPatch1::Type::name () const {
@@ -306,6 +487,14 @@ namespace embree
     return sizeof(SubdivPatch1);
   }
 
+  unsigned int SubdivPatch1::Type::getGeomID(const char* This, size_t i) const {
+    return ((SubdivPatch1*)This)->geomID();
+  }
+
+  unsigned int SubdivPatch1::Type::getPrimID(const char* This, size_t i) const {
+    return ((SubdivPatch1*)This)->primID();
+  }
+
   SubdivPatch1::Type SubdivPatch1::type;
 
   /********************** Virtual Object **************************/
@@ -326,6 +515,14 @@ namespace embree
     return sizeof(Object);
   }
 
+  unsigned int Object::Type::getGeomID(const char* This, size_t i) const {
+    return ((Object*)This)->geomID();
+  }
+
+  unsigned int Object::Type::getPrimID(const char* This, size_t i) const {
+    return ((Object*)This)->primID();
+  }
+
   Object::Type Object::type;
 
   /********************** Instance **************************/
@@ -346,6 +543,14 @@ namespace embree
     return sizeof(InstancePrimitive);
   }
 
+  unsigned int InstancePrimitive::Type::getGeomID(const char* This, size_t i) const {
+    return ((InstancePrimitive*)This)->instance->geomID;
+  }
+
+  unsigned int InstancePrimitive::Type::getPrimID(const char* This, size_t i) const {
+    return 0;
+  }
+
   InstancePrimitive::Type InstancePrimitive::type;
 
   /********************** SubGrid **************************/
@@ -366,6 +571,14 @@ namespace embree
     return sizeof(SubGrid);
   }
 
+  unsigned int SubGrid::Type::getGeomID(const char* This, size_t i) const {
+    return ((SubGrid*)This)->geomID();
+  }
+
+  unsigned int SubGrid::Type::getPrimID(const char* This, size_t i) const {
+    return ((SubGrid*)This)->primID();
+  }
+
   SubGrid::Type SubGrid::type;
   
   /********************** SubGridQBVH4 **************************/
@@ -377,16 +590,58 @@ namespace embree
 
   template<>
   size_t SubGridQBVH4::Type::sizeActive(const char* This) const {
-    return 1;
+    return ((SubGridQBVH4*)This)->size();
   }
 
   template<>
   size_t SubGridQBVH4::Type::sizeTotal(const char* This) const {
-    return 1;
+    return 4;
   }
 
   template<>
   size_t SubGridQBVH4::Type::getBytes(const char* This) const {
     return sizeof(SubGridQBVH4);
   }
+
+  template<>
+  unsigned int SubGridQBVH4::Type::getGeomID(const char* This, size_t i) const {
+    return ((SubGridQBVH4*)This)->geomID();
+  }
+
+  template<>
+  unsigned int SubGridQBVH4::Type::getPrimID(const char* This, size_t i) const {
+    return ((SubGridQBVH4*)This)->primID(i);
+  }
+
+  /********************** SubGridMBQBVH4 **************************/
+
+  template<>
+  const char* SubGridMBQBVH4::Type::name () const {
+    return "SubGridMBQBVH4";
+  }
+
+  template<>
+  size_t SubGridMBQBVH4::Type::sizeActive(const char* This) const {
+    return ((SubGridMBQBVH4*)This)->size();
+  }
+
+  template<>
+  size_t SubGridMBQBVH4::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t SubGridMBQBVH4::Type::getBytes(const char* This) const {
+    return sizeof(SubGridMBQBVH4);
+  }
+
+  template<>
+  unsigned int SubGridMBQBVH4::Type::getGeomID(const char* This, size_t i) const {
+    return ((SubGridMBQBVH4*)This)->geomID();
+  }
+
+  template<>
+  unsigned int SubGridMBQBVH4::Type::getPrimID(const char* This, size_t i) const {
+    return ((SubGridMBQBVH4*)This)->primID(i);
+  }
 }
@@ -19,6 +19,7 @@
 #include "curveNi.h"
 #include "curveNi_mb.h"
 #include "linei.h"
+#include "pointi.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglev_mb.h"
@@ -42,7 +43,9 @@ namespace embree
   template<>
   size_t Curve8v::Type::sizeActive(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->size();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return ((Line8i*)This)->size();
     else
       return ((Curve8v*)This)->N;
@@ -51,7 +54,9 @@ namespace embree
   template<>
   size_t Curve8v::Type::sizeTotal(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return 8;
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return 8;
     else
       return ((Curve8v*)This)->N;
@@ -60,12 +65,34 @@ namespace embree
   template<>
   size_t Curve8v::Type::getBytes(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+       return Point8i::bytes(sizeActive(This));
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
        return Line8i::bytes(sizeActive(This));
      else
        return Curve8v::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve8v::Type::getGeomID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->geomID();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->geomID();
+    else
+      return ((Curve8v*)This)->geomID(((Curve8v*)This)->N);
+  }
+
+  template<>
+  unsigned int Curve8v::Type::getPrimID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->primID(i);
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->primID(i);
+    else
+      return ((Curve8v*)This)->primID(((Curve8v*)This)->N)[i];
+  }
+
   /********************** Curve8i **************************/
 
   template<>
@@ -76,7 +103,9 @@ namespace embree
   template<>
   size_t Curve8i::Type::sizeActive(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->size();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return ((Line8i*)This)->size();
     else
       return ((Curve8i*)This)->N;
@@ -85,7 +114,9 @@ namespace embree
   template<>
   size_t Curve8i::Type::sizeTotal(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return 8;
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return 8;
     else
       return ((Curve8i*)This)->N;
@@ -94,12 +125,34 @@ namespace embree
   template<>
   size_t Curve8i::Type::getBytes(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+       return Point8i::bytes(sizeActive(This));
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
        return Line8i::bytes(sizeActive(This));
      else
        return Curve8i::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve8i::Type::getGeomID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->geomID();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->geomID();
+    else
+      return ((Curve8i*)This)->geomID(((Curve8i*)This)->N);
+  }
+
+  template<>
+  unsigned int Curve8i::Type::getPrimID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->primID(i);
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->primID(i);
+    else
+      return ((Curve8i*)This)->primID(((Curve8i*)This)->N)[i];
+  }
+
   /********************** Curve8iMB **************************/
 
   template<>
@@ -110,7 +163,9 @@ namespace embree
   template<>
   size_t Curve8iMB::Type::sizeActive(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->size();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return ((Line8i*)This)->size();
     else
       return ((Curve8iMB*)This)->N;
@@ -119,7 +174,9 @@ namespace embree
   template<>
   size_t Curve8iMB::Type::sizeTotal(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return 8;
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
       return 8;
     else
       return ((Curve8iMB*)This)->N;
@@ -128,12 +185,34 @@ namespace embree
   template<>
   size_t Curve8iMB::Type::getBytes(const char* This) const
   {
-    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+    if ((1 << *This) & Geometry::MTY_POINTS)
+       return Point8i::bytes(sizeActive(This));
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
        return Line8i::bytes(sizeActive(This));
      else
        return Curve8iMB::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve8iMB::Type::getGeomID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->geomID();
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->geomID();
+    else
+      return ((Curve8iMB*)This)->geomID(((Curve8iMB*)This)->N);
+  }
+
+  template<>
+  unsigned int Curve8iMB::Type::getPrimID(const char* This, size_t i) const {
+    if ((1 << *This) & Geometry::MTY_POINTS)
+      return ((Point8i*)This)->primID(i);
+    else if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->primID(i);
+    else
+      return ((Curve8iMB*)This)->primID(((Curve8iMB*)This)->N)[i];
+  }
+
   /********************** SubGridQBVH8 **************************/
 
   template<>
@@ -143,16 +222,58 @@ namespace embree
 
   template<>
   size_t SubGridQBVH8::Type::sizeActive(const char* This) const {
-    return 1;
+    return ((SubGridQBVH8*)This)->size();
   }
 
   template<>
   size_t SubGridQBVH8::Type::sizeTotal(const char* This) const {
-    return 1;
+    return 8;
   }
 
   template<>
   size_t SubGridQBVH8::Type::getBytes(const char* This) const {
     return sizeof(SubGridQBVH8);
   }
+
+  template<>
+  unsigned int SubGridQBVH8::Type::getGeomID(const char* This, size_t i) const {
+    return ((SubGridQBVH8*)This)->geomID();
+  }
+
+  template<>
+  unsigned int SubGridQBVH8::Type::getPrimID(const char* This, size_t i) const {
+    return ((SubGridQBVH8*)This)->primID(i);
+  }
+
+  /********************** SubGridMBQBVH8 **************************/
+
+  template<>
+  const char* SubGridMBQBVH8::Type::name () const {
+    return "SubGridMBQBVH8";
+  }
+
+  template<>
+  size_t SubGridMBQBVH8::Type::sizeActive(const char* This) const {
+    return ((SubGridMBQBVH8*)This)->size();
+  }
+
+  template<>
+  size_t SubGridMBQBVH8::Type::sizeTotal(const char* This) const {
+    return 8;
+  }
+
+  template<>
+  size_t SubGridMBQBVH8::Type::getBytes(const char* This) const {
+    return sizeof(SubGridMBQBVH8);
+  }
+
+  template<>
+  unsigned int SubGridMBQBVH8::Type::getGeomID(const char* This, size_t i) const {
+    return ((SubGridMBQBVH8*)This)->geomID();
+  }
+
+  template<>
+  unsigned int SubGridMBQBVH8::Type::getPrimID(const char* This, size_t i) const {
+    return ((SubGridMBQBVH8*)This)->primID(i);
+  }
 }
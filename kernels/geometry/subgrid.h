@@ -32,6 +32,8 @@ namespace embree
           size_t sizeActive(const char* This) const;
           size_t sizeTotal(const char* This) const;
           size_t getBytes(const char* This) const;
+          unsigned int getGeomID(const char* This, size_t i) const;
+          unsigned int getPrimID(const char* This, size_t i) const;
         };
         static Type type;
 
@@ -332,6 +334,8 @@ namespace embree
           size_t sizeActive(const char* This) const;
           size_t sizeTotal(const char* This) const;
           size_t getBytes(const char* This) const;
+          unsigned int getGeomID(const char* This, size_t i) const;
+          unsigned int getPrimID(const char* This, size_t i) const;
         };
         static Type type;
 
@@ -427,6 +431,8 @@ namespace embree
           size_t sizeActive(const char* This) const;
           size_t sizeTotal(const char* This) const;
           size_t getBytes(const char* This) const;
+          unsigned int getGeomID(const char* This, size_t i) const;
+          unsigned int getPrimID(const char* This, size_t i) const;
         };
         static Type type;
 
@@ -527,4 +533,10 @@ namespace embree
 
       };
 
+      template<int N>
+        typename SubGridMBQBVHN<N>::Type SubGridMBQBVHN<N>::type;
+
+      typedef SubGridMBQBVHN<4> SubGridMBQBVH4;
+      typedef SubGridMBQBVHN<8> SubGridMBQBVH8;
+
 }
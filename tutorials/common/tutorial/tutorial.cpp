@@ -284,6 +284,10 @@ namespace embree
         g_iflags_coherent   = iflags_coherent   = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
         g_iflags_incoherent = iflags_incoherent = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
       }, "--incoherent: force using RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT hint when tracing rays");
+
+    registerOption("sort-rays", [this] (Ref<ParseStream> cin, const FileName& path) {
+        g_iflags_incoherent = iflags_incoherent = (RTCIntersectContextFlags) (iflags_incoherent | RTC_INTERSECT_CONTEXT_FLAG_SORT_RAYS);
+      }, "--sort-rays: sets RTC_INTERSECT_CONTEXT_FLAG_SORT_RAYS hint to reorder incoherent ray streams in stream mode");
   }
 
   TutorialApplication::~TutorialApplication()
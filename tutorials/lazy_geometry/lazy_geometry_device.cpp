@@ -182,7 +182,7 @@ void instanceIntersectFuncN(const RTCIntersectFunctionNArguments* args)
   ray->geomID = RTC_INVALID_GEOMETRY_ID;
   rtcIntersect1(instance->object,context,RTCRayHit_(*ray));
   if (ray->geomID == RTC_INVALID_GEOMETRY_ID) ray->geomID = geomID;
-  else ray->instID = instance->userID;
+  else ray->instID[0] = instance->userID;
 }
 
 void instanceOccludedFuncN(const RTCOccludedFunctionNArguments* args)
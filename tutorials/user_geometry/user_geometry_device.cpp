@@ -1016,16 +1016,16 @@ Vec3fa renderPixelStandard(float x, float y, const ISPCCamera& camera, RayStats&
     /* calculate shading normal in world space */
     Vec3fa Ns = ray.Ng;
 
-    if (ray.instID != RTC_INVALID_GEOMETRY_ID) {
-      Ns = xfmVector(g_instance[ray.instID]->normal2world,Vec3fa(Ns));
+    if (ray.instID[0] != RTC_INVALID_GEOMETRY_ID) {
+      Ns = xfmVector(g_instance[ray.instID[0]]->normal2world,Vec3fa(Ns));
     }
     Ns = face_forward(ray.dir,normalize(Ns));
 
     /* calculate diffuse color of geometries */
     Vec3fa diffuse = Vec3fa(0.0f);
-    if      (ray.instID ==  0) diffuse = colors[ray.instID][ray.primID];
-    else if (ray.instID == -1) diffuse = colors[4][ray.primID];
-    else                       diffuse = colors[ray.instID][ray.geomID];
+    if      (ray.instID[0] ==  0) diffuse = colors[ray.instID[0]][ray.primID];
+    else if (ray.instID[0] == -1) diffuse = colors[4][ray.primID];
+    else                       diffuse = colors[ray.instID[0]][ray.geomID];
     color = color + diffuse*0.5;
 
     /* initialize shadow ray */
@@ -1159,9 +1159,9 @@ void renderTileStandardStream(int taskIndex,
 
     /* calculate diffuse color of geometries */
     Vec3fa diffuse = Vec3fa(0.0f);
-    if      (primary.instID ==  0) diffuse = colors[primary.instID][primary.primID];
-    else if (primary.instID == -1) diffuse = colors[4][primary.primID];      
-    else                           diffuse = colors[primary.instID][primary.geomID];
+    if      (primary.instID[0] ==  0) diffuse = colors[primary.instID[0]][primary.primID];
+    else if (primary.instID[0] == -1) diffuse = colors[4][primary.primID];      
+    else                           diffuse = colors[primary.instID[0]][primary.geomID];
     color_stream[N] = color_stream[N] + diffuse*0.5;
 
     /* initialize shadow ray */
@@ -1195,16 +1195,16 @@ void renderTileStandardStream(int taskIndex,
     /* calculate shading normal in world space */
     Ray& primary = primary_stream[N];
     Vec3fa Ns = primary.Ng;
-    if (primary.instID != RTC_INVALID_GEOMETRY_ID) {
-      Ns = xfmVector(g_instance[primary.instID]->normal2world,Vec3fa(Ns));
+    if (primary.instID[0] != RTC_INVALID_GEOMETRY_ID) {
+      Ns = xfmVector(g_instance[primary.instID[0]]->normal2world,Vec3fa(Ns));
     }
     Ns = face_forward(primary.dir,normalize(Ns));
     
     /* add light contrinution */
     Vec3fa diffuse = Vec3fa(0.0f);
-    if      (primary.instID ==  0) diffuse = colors[primary.instID][primary.primID];
-    else if (primary.instID == -1) diffuse = colors[4][primary.primID];      
-    else                           diffuse = colors[primary.instID][primary.geomID];
+    if      (primary.instID[0] ==  0) diffuse = colors[primary.instID[0]][primary.primID];
+    else if (primary.instID[0] == -1) diffuse = colors[4][primary.primID];      
+    else                           diffuse = colors[primary.instID[0]][primary.geomID];
     Ray& shadow = shadow_stream[N];
     if (shadow.tfar >= 0.0f) {
       color_stream[N] = color_stream[N] + diffuse*clamp(-dot(lightDir,Ns),0.0f,1.0f);
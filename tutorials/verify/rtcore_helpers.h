@@ -146,7 +146,7 @@ namespace embree
     rh.hit.v = 0.0f;
     rh.hit.geomID = -1;
     rh.hit.primID = -1;
-    rh.hit.instID[0] = -1;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rh.hit.instID[l] = -1;
   }
 
   __forceinline RTCRayHit makeRay(const Vec3fa& org, const Vec3fa& dir) 
@@ -156,7 +156,8 @@ namespace embree
     rh.ray.dir_x = dir.x; rh.ray.dir_y = dir.y; rh.ray.dir_z = dir.z;
     rh.ray.tnear = 0.0f; rh.ray.tfar = inf;
     rh.ray.time = 0; rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -167,7 +168,8 @@ namespace embree
     rh.ray.dir_x = dir.x; rh.ray.dir_y = dir.y; rh.ray.dir_z = dir.z;
     rh.ray.tnear = tnear; rh.ray.tfar = tfar;
     rh.ray.time = 0; rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -180,7 +182,8 @@ namespace embree
     rh.ray.tfar = inf;
     rh.ray.time = 0; 
     rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -197,7 +200,8 @@ namespace embree
     rh.ray.tfar = inf;
     rh.ray.time = 0; 
     rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rh.hit.instID[l] = -1;
   }
 
   __forceinline void fastMakeRay(RTCRayHit& ray, const Vec3fa& org, RandomSampler& sampler)
@@ -212,7 +216,8 @@ namespace embree
     rh.ray.dir_x = dir.x; rh.ray.dir_y = dir.y; rh.ray.dir_z = dir.z;
     rh.ray.tnear = tnear; rh.ray.tfar = tfar;
     rh.ray.time = 0; rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -230,7 +235,7 @@ namespace embree
     if (*(int*)&ray0.ray.mask   != *(int*)&ray1.ray.mask  ) return true;
     if (*(int*)&ray0.hit.u      != *(int*)&ray1.hit.u     ) return true;
     if (*(int*)&ray0.hit.v      != *(int*)&ray1.hit.v     ) return true;
-    if (*(int*)&ray0.hit.instID[0] != *(int*)&ray1.hit.instID[0]) return true;
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) if (*(int*)&ray0.hit.instID[l] != *(int*)&ray1.hit.instID[l]) return true;
     if (*(int*)&ray0.hit.geomID != *(int*)&ray1.hit.geomID) return true;
     if (*(int*)&ray0.hit.primID != *(int*)&ray1.hit.primID) return true;
     if (*(int*)&ray0.hit.Ng_x  != *(int*)&ray1.hit.Ng_x ) return true;
@@ -270,7 +275,7 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
-    ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l][i] = ray_i.hit.instID[l];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
     ray_o.hit.u[i] = ray_i.hit.u;
@@ -292,7 +297,7 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
-    ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l][i] = ray_i.hit.instID[l];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
     ray_o.hit.u[i] = ray_i.hit.u;
@@ -314,7 +319,7 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
-    ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l][i] = ray_i.hit.instID[l];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
     ray_o.hit.u[i] = ray_i.hit.u;
@@ -338,7 +343,7 @@ namespace embree
     RTCRayN_time(ray_o,N,i) = ray_i.ray.time;
     RTCRayN_mask(ray_o,N,i) = ray_i.ray.mask;
     RTCHitN* hit_o = RTCRayHitN_HitN(rayhit_o,N);
-    RTCHitN_instID(hit_o,N,i,0) = ray_i.hit.instID[0];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) RTCHitN_instID(hit_o,N,i,l) = ray_i.hit.instID[l];
     RTCHitN_geomID(hit_o,N,i) = ray_i.hit.geomID;
     RTCHitN_primID(hit_o,N,i) = ray_i.hit.primID;
     RTCHitN_u(hit_o,N,i) = ray_i.hit.u;
@@ -361,7 +366,7 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
-    ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l] = ray_i.hit.instID[l][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
     ray_o.hit.u = ray_i.hit.u[i];
@@ -385,7 +390,7 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
-    ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l] = ray_i.hit.instID[l][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
     ray_o.hit.u = ray_i.hit.u[i];
@@ -409,7 +414,7 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
-    ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l] = ray_i.hit.instID[l][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
     ray_o.hit.u = ray_i.hit.u[i];
@@ -435,7 +440,7 @@ namespace embree
     ray_o.ray.tfar  = RTCRayN_tfar(ray_i,N,i);
     ray_o.ray.time = RTCRayN_time(ray_i,N,i);
     ray_o.ray.mask = RTCRayN_mask(ray_i,N,i);
-    ray_o.hit.instID[0] = RTCHitN_instID(hit_i,N,i,0);
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) ray_o.hit.instID[l] = RTCHitN_instID(hit_i,N,i,l);
     ray_o.hit.geomID = RTCHitN_geomID(hit_i,N,i);
     ray_o.hit.primID = RTCHitN_primID(hit_i,N,i);
     ray_o.hit.u = RTCHitN_u(hit_i,N,i);
@@ -579,6 +584,8 @@ namespace embree
     if (scene_flags & RTC_SCENE_FLAG_COMPACT) ret += "Compact";
     if (scene_flags & RTC_SCENE_FLAG_ROBUST ) ret += "Robust";
     if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST)) ret += "Fast"; 
+    if (scene_flags & RTC_SCENE_FLAG_NUMA_REPLICATION) ret += "Replicated";
+    if (scene_flags & RTC_SCENE_FLAG_LOW_MEMORY_BUILD) ret += "LowMemory";
     return ret;
   }
   
@@ -691,7 +698,7 @@ namespace embree
     rayp.ray.mask = &RTCRayN_mask(ray, N, 0);
     rayp.ray.id = &RTCRayN_id(ray, N, 0);
     rayp.ray.flags = &RTCRayN_flags(ray, N, 0);
-    rayp.hit.instID[0] = &RTCHitN_instID(hit, N, 0, 0);
+    for (unsigned l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++) rayp.hit.instID[l] = &RTCHitN_instID(hit, N, 0, l);
     rayp.hit.geomID = &RTCHitN_geomID(hit, N, 0);
     rayp.hit.primID = &RTCHitN_primID(hit, N, 0);
     rayp.hit.u = &RTCHitN_u(hit, N, 0);
@@ -709,11 +716,12 @@ namespace embree
     for (unsigned int j = 0; j < N; j++) rays[j] = getRay(rayhit, N, j);
   }
 	
-  __noinline void IntersectWithModeInternal(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N)
+  __noinline void IntersectWithModeInternal(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N, RTCIntersectContextFlags flags = RTC_INTERSECT_CONTEXT_FLAG_NONE)
   {
     RTCIntersectContext context;
     rtcInitIntersectContext(&context);
     context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_CONTEXT_FLAG_COHERENT :  RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
+    context.flags = (RTCIntersectContextFlags) (context.flags | flags);
 
     switch (mode) 
     {
@@ -834,7 +842,7 @@ namespace embree
     }
   }
 
-  void IntersectWithMode(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N)
+  void IntersectWithMode(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRayHit* rays, unsigned int N, RTCIntersectContextFlags flags = RTC_INTERSECT_CONTEXT_FLAG_NONE)
   {
     /* verify occluded result against intersect */
     if ((ivariant & VARIANT_INTERSECT_OCCLUDED) == VARIANT_INTERSECT_OCCLUDED)
@@ -845,8 +853,8 @@ namespace embree
         valid[i] = rays[i].ray.tnear <= rays[i].ray.tfar;
         rays2[i] = rays[i];
       }
-      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_OCCLUDED),scene,rays,N);
-      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_INTERSECT),scene,rays2.data(),N);
+      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_OCCLUDED),scene,rays,N,flags);
+      IntersectWithModeInternal(mode,IntersectVariant(ivariant & ~VARIANT_INTERSECT),scene,rays2.data(),N,flags);
       for (size_t i=0; i<N; i++)
       {
         if (valid[i] && ((rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) != (rays2[i].ray.tfar != float(neg_inf)))) {
@@ -855,7 +863,7 @@ namespace embree
       }
     }
     else
-      IntersectWithModeInternal(mode,ivariant,scene,rays,N);
+      IntersectWithModeInternal(mode,ivariant,scene,rays,N,flags);
   }
 
   enum GeometryType
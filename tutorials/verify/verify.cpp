@@ -21,6 +21,7 @@
 #include "../common/scenegraph/geometry_creation.h"
 #include "../../common/algorithms/parallel_for.h"
 #include <regex>
+#include <set>
 #include <stack>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -1140,6 +1141,272 @@ namespace embree
     }
   };
 
+  struct SaveLoadSceneBVHTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality; 
+
+    SaveLoadSceneBVHTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      const Vec3fa dx(1,0,0);
+      const Vec3fa dy(0,1,0);
+      std::vector<Ref<SceneGraph::Node>> nodes;
+      nodes.push_back(SceneGraph::createTriangleSphere(center,radius,50));
+      nodes.push_back(SceneGraph::createTriangleSphere(center,radius,50)->set_motion_vector(random_motion_vector(1.0f)));
+      nodes.push_back(SceneGraph::createQuadSphere(center,radius,50));
+      nodes.push_back(SceneGraph::createGridSphere(center,radius,50));
+      nodes.push_back(SceneGraph::createHairyPlane(RandomSampler_getInt(sampler),center,dx,dy,0.1f,0.01f,100,SceneGraph::FLAT_CURVE));
+
+      VerifyScene scene0(device,sflags);
+      VerifyScene scene1(device,sflags);
+      for (auto& node : nodes) {
+        scene0.addGeometry(quality,node);
+        scene1.addGeometry(quality,node);
+      }
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      const std::string fileName = "verify_scene_bvh_"+std::to_string((size_t)this)+".bin";
+      rtcSaveSceneBVH(scene0,fileName.c_str());
+      AssertNoError(device);
+      rtcLoadSceneBVH(scene1,fileName.c_str());
+      AssertNoError(device);
+
+      /* a scene with different geometry must get rejected */
+      VerifyScene scene2(device,sflags);
+      scene2.addGeometry(quality,nodes[0]);
+      rtcLoadSceneBVH(scene2,fileName.c_str());
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      remove(fileName.c_str());
+
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(org,dir);
+        ray0.ray.time = random_float();
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar)
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CommitSceneAsyncTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality; 
+
+    CommitSceneAsyncTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static bool cancelBuild(void* ptr, double n) {
+      return false;
+    }
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* scene of the previous frame */
+      VerifyScene scene0(device,sflags);
+      unsigned geom0 = scene0.addSphere(sampler,quality,zero,1.0f,50).first;
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      /* scene of the next frame gets committed in the background */
+      VerifyScene scene1(device,sflags);
+      std::vector<unsigned> geomIDs;
+      for (size_t i=0; i<16; i++)
+        geomIDs.push_back(scene1.addSphere(sampler,quality,Vec3fa(4.0f*float(i),0.0f,0.0f),1.0f,200).first);
+      RTCCommitFuture future = rtcCommitSceneAsync(scene1);
+      AssertNoError(device);
+
+      /* trace the previous scene while the next one builds */
+      bool ok = true;
+      do {
+        RTCRayHit ray = makeRay(Vec3fa(0.1f,10.0f,0.1f),Vec3fa(0,-1,0));
+        rtcIntersect1(scene0,&context,&ray);
+        ok &= ray.hit.geomID == geom0;
+      } while (!rtcIsCommitFutureReady(future));
+      rtcWaitCommitFuture(future);
+      rtcReleaseCommitFuture(future);
+      AssertNoError(device);
+      if (!ok) return VerifyApplication::FAILED;
+
+      for (size_t i=0; i<geomIDs.size(); i++) {
+        RTCRayHit ray = makeRay(Vec3fa(4.0f*float(i)+0.1f,10.0f,0.1f),Vec3fa(0,-1,0));
+        rtcIntersect1(scene1,&context,&ray);
+        if (ray.hit.geomID != geomIDs[i]) return VerifyApplication::FAILED;
+      }
+
+      /* errors of the commit get reported when waiting for the future */
+      VerifyScene scene2(device,sflags);
+      scene2.addSphere(sampler,quality,zero,1.0f,50);
+      rtcSetSceneProgressMonitorFunction(scene2,cancelBuild,nullptr);
+      future = rtcCommitSceneAsync(scene2);
+      AssertNoError(device);
+      rtcWaitCommitFuture(future);
+      AssertError(device,RTC_ERROR_CANCELLED);
+      rtcReleaseCommitFuture(future);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct PointQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality; 
+
+    PointQueryTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    struct QueryData
+    {
+      std::vector<Ref<SceneGraph::TriangleMeshNode>> meshes;
+      bool nearest;
+      std::set<std::pair<unsigned,unsigned>> found;
+    };
+
+    static Vec3fa closestPointTriangle(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+    {
+      const Vec3fa ab = b-a, ac = c-a, ap = p-a;
+      const float d1 = dot(ab,ap), d2 = dot(ac,ap);
+      if (d1 <= 0.0f && d2 <= 0.0f) return a;
+      const Vec3fa bp = p-b;
+      const float d3 = dot(ab,bp), d4 = dot(ac,bp);
+      if (d3 >= 0.0f && d4 <= d3) return b;
+      const Vec3fa cp = p-c;
+      const float d5 = dot(ab,cp), d6 = dot(ac,cp);
+      if (d6 >= 0.0f && d5 <= d6) return c;
+      const float vc = d1*d4 - d3*d2;
+      if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + d1/(d1-d3)*ab;
+      const float vb = d5*d2 - d1*d6;
+      if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + d2/(d2-d6)*ac;
+      const float va = d3*d6 - d5*d4;
+      if (va <= 0.0f && d4-d3 >= 0.0f && d5-d6 >= 0.0f) return b + (d4-d3)/((d4-d3)+(d5-d6))*(c-b);
+      const float denom = 1.0f/(va+vb+vc);
+      return a + vb*denom*ab + vc*denom*ac;
+    }
+
+    static float primitiveDistance(const QueryData* data, unsigned geomID, unsigned primID, const Vec3fa& p)
+    {
+      const SceneGraph::TriangleMeshNode* mesh = data->meshes[geomID].ptr;
+      const SceneGraph::TriangleMeshNode::Triangle& tri = mesh->triangles[primID];
+      const Vec3fa q = closestPointTriangle(p,mesh->positions[0][tri.v0],mesh->positions[0][tri.v1],mesh->positions[0][tri.v2]);
+      return length(q-p);
+    }
+
+    static bool reportPrimitive(RTCPointQueryFunctionArguments* args)
+    {
+      QueryData* data = (QueryData*) args->userPtr;
+      RTCPointQuery* query = args->query;
+      const float d = primitiveDistance(data,args->geomID,args->primID,Vec3fa(query->x,query->y,query->z));
+      if (d > query->radius) return false;
+      if (!data->nearest) {
+        data->found.insert(std::make_pair(args->geomID,args->primID));
+        return false;
+      }
+      query->radius = d;
+      return true;
+    }
+
+    /* the scene callback skips geometry 1, which has its own callback that has to take precedence */
+    static bool scenePointQueryFunc(RTCPointQueryFunctionArguments* args) {
+      if (args->geomID == 1) return false;
+      return reportPrimitive(args);
+    }
+
+    static bool geometryPointQueryFunc(RTCPointQueryFunctionArguments* args) {
+      return reportPrimitive(args);
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      QueryData data;
+      data.meshes.push_back(SceneGraph::createTriangleSphere(Vec3fa(-0.5f,0.0f,0.0f),0.5f,20).dynamicCast<SceneGraph::TriangleMeshNode>());
+      data.meshes.push_back(SceneGraph::createTriangleSphere(Vec3fa(+0.5f,0.2f,0.0f),0.4f,20).dynamicCast<SceneGraph::TriangleMeshNode>());
+
+      VerifyScene scene(device,sflags);
+      for (auto& mesh : data.meshes)
+        scene.addGeometry(quality,mesh.dynamicCast<SceneGraph::Node>());
+      rtcSetGeometryPointQueryFunction(rtcGetGeometry(scene,1),geometryPointQueryFunc);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<200; i++)
+      {
+        const Vec3fa p = 3.0f*random_Vec3fa() - Vec3fa(1.5f);
+
+        /* brute force reference */
+        float nearest = inf;
+        std::set<std::pair<unsigned,unsigned>> inside, insideConservative;
+        const float radius = 0.3f;
+        for (unsigned geomID=0; geomID<data.meshes.size(); geomID++) {
+          for (unsigned primID=0; primID<data.meshes[geomID]->triangles.size(); primID++) {
+            const float d = primitiveDistance(&data,geomID,primID,p);
+            nearest = min(nearest,d);
+            if (d <= radius) inside.insert(std::make_pair(geomID,primID));
+            if (d <= 0.99f*radius) insideConservative.insert(std::make_pair(geomID,primID));
+          }
+        }
+
+        /* closest point query with shrinking radius */
+        RTCPointQuery query;
+        query.x = p.x; query.y = p.y; query.z = p.z;
+        query.time = 0.0f;
+        query.radius = inf;
+        data.nearest = true;
+        if (!rtcPointQuery(scene,&query,scenePointQueryFunc,&data))
+          return VerifyApplication::FAILED;
+        if (abs(query.radius-nearest) > 1E-5f)
+          return VerifyApplication::FAILED;
+
+        /* radius query */
+        query.radius = radius;
+        data.nearest = false;
+        data.found.clear();
+        if (rtcPointQuery(scene,&query,scenePointQueryFunc,&data))
+          return VerifyApplication::FAILED;
+        for (auto& prim : data.found)
+          if (inside.find(prim) == inside.end()) return VerifyApplication::FAILED;
+        for (auto& prim : insideConservative)
+          if (data.found.find(prim) == data.found.end()) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1443,6 +1710,300 @@ namespace embree
       return ret;
     }
   };
+
+  static std::atomic<ssize_t> build_memory_bytes_used(0);
+  static std::atomic<ssize_t> build_memory_peak_bytes(0);
+
+  struct BuildMemoryBudgetTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    BuildMemoryBudgetTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static bool memoryMonitor(void* userPtr, const ssize_t bytes, const bool /*post*/)
+    {
+      const ssize_t used = build_memory_bytes_used += bytes;
+      ssize_t peak = build_memory_peak_bytes;
+      while (used > peak && !build_memory_peak_bytes.compare_exchange_weak(peak,used));
+      return true;
+    }
+
+    /* commits the scene and returns the peak memory consumption of the build */
+    static ssize_t commit(RTCScene scene)
+    {
+      const ssize_t bytes0 = build_memory_bytes_used;
+      build_memory_peak_bytes = bytes0;
+      rtcCommitScene(scene);
+      return build_memory_peak_bytes-bytes0;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      rtcSetDeviceMemoryMonitorFunction(device,memoryMonitor,nullptr);
+
+      Ref<SceneGraph::Node> mesh = SceneGraph::createTriangleSphere(zero,1.0f,200);
+
+      /* the estimate is available before the first commit */
+      VerifyScene scene0(device,sflags);
+      scene0.addGeometry(quality,mesh);
+      const size_t estimate0 = rtcGetSceneBuildMemoryEstimate(scene0);
+      AssertNoError(device);
+      const ssize_t peak0 = commit(scene0);
+      AssertNoError(device);
+      if (estimate0 == 0 || rtcGetSceneBuildMemoryEstimate(scene0) != estimate0)
+        return VerifyApplication::FAILED;
+
+      /* a budget below the estimate has to reduce the memory consumption */
+      VerifyScene scene1(device,sflags);
+      scene1.addGeometry(quality,mesh);
+      rtcSetSceneBuildMemoryBudget(scene1,estimate0/2);
+      const size_t estimate1 = rtcGetSceneBuildMemoryEstimate(scene1);
+      const ssize_t peak1 = commit(scene1);
+      AssertNoError(device);
+      if (estimate1 >= estimate0 || peak1 > peak0)
+        return VerifyApplication::FAILED;
+
+      /* both scenes have to find the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        if (ray0.hit.geomID != ray1.hit.geomID || ray0.ray.tfar != ray1.ray.tfar)
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct LowMemoryBuildTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    LowMemoryBuildTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      rtcSetDeviceMemoryMonitorFunction(device,BuildMemoryBudgetTest::memoryMonitor,nullptr);
+
+      Ref<SceneGraph::Node> mesh = SceneGraph::createTriangleSphere(zero,1.0f,200);
+
+      VerifyScene scene0(device,sflags);
+      scene0.addGeometry(quality,mesh);
+      const size_t estimate0 = rtcGetSceneBuildMemoryEstimate(scene0);
+      const ssize_t peak0 = BuildMemoryBudgetTest::commit(scene0);
+      AssertNoError(device);
+
+      /* allocating the BVH inside the primref array has to reduce the peak memory consumption */
+      VerifyScene scene1(device,SceneFlags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_LOW_MEMORY_BUILD),sflags.qflags));
+      scene1.addGeometry(quality,mesh);
+      const size_t estimate1 = rtcGetSceneBuildMemoryEstimate(scene1);
+      const ssize_t peak1 = BuildMemoryBudgetTest::commit(scene1);
+      AssertNoError(device);
+      if (estimate1 >= estimate0 || peak1 >= peak0)
+        return VerifyApplication::FAILED;
+
+      /* both scenes have to find the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar)
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct OutOfCoreBuildTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    OutOfCoreBuildTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg0 = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg0.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+
+      /* small chunks such that the scene gets split into many sub-BVHs */
+      std::string cfg1 = cfg0 + ",out_of_core_directory=\".\",out_of_core_chunk_size=5000";
+      RTCDeviceRef device1 = rtcNewDevice(cfg1.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      Ref<SceneGraph::Node> mesh0 = SceneGraph::createTriangleSphere(Vec3fa(-0.5f,0.0f,0.0f),1.0f,200);
+      Ref<SceneGraph::Node> mesh1 = SceneGraph::createTriangleSphere(Vec3fa(+0.5f,0.0f,0.0f),1.0f,50);
+
+      VerifyScene scene0(device0,sflags);
+      scene0.addGeometry(quality,mesh0);
+      scene0.addGeometry(quality,mesh1);
+      const size_t estimate0 = rtcGetSceneBuildMemoryEstimate(scene0);
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+
+      VerifyScene scene1(device1,sflags);
+      scene1.addGeometry(quality,mesh0);
+      scene1.addGeometry(quality,mesh1);
+      const size_t estimate1 = rtcGetSceneBuildMemoryEstimate(scene1);
+      rtcCommitScene(scene1);
+      AssertNoError(device1);
+
+      /* only the primrefs of a single chunk are needed during the build */
+      if (estimate1 >= estimate0)
+        return VerifyApplication::FAILED;
+
+      /* both scenes have to find the same hits */
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = 3.0f*random_Vec3fa() - Vec3fa(1.5f);
+        const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = ray0;
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar)
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct AllocArenaTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    AllocArenaTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg0 = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg0.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+
+      std::string cfg1 = cfg0 + ",alloc_arena_size=64";
+      RTCDeviceRef device1 = rtcNewDevice(cfg1.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      Ref<SceneGraph::Node> mesh = SceneGraph::createTriangleSphere(Vec3fa(0.0f,0.0f,0.0f),1.0f,200);
+
+      VerifyScene scene0(device0,sflags);
+      scene0.addGeometry(quality,mesh);
+      rtcCommitScene(scene0);
+      AssertNoError(device0);
+
+      /* later scenes get built into the blocks pooled by earlier ones */
+      for (size_t j=0; j<3; j++)
+      {
+        VerifyScene scene1(device1,sflags);
+        scene1.addGeometry(quality,mesh);
+        rtcCommitScene(scene1);
+        AssertNoError(device1);
+
+        for (size_t i=0; i<1000; i++)
+        {
+          const Vec3fa org = 3.0f*random_Vec3fa() - Vec3fa(1.5f);
+          const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = ray0;
+          rtcIntersect1(scene0,&context,&ray0);
+          rtcIntersect1(scene1,&context,&ray1);
+          if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar)
+            return VerifyApplication::FAILED;
+        }
+        AssertNoError(device1);
+      }
+      AssertNoError(device0);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+    
+  struct BuildStatisticsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    BuildStatisticsTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(Vec3fa(-1.0f,0.0f,0.0f),1.0f,200));
+      scene.addGeometry(quality,SceneGraph::createTriangleSphere(Vec3fa(+1.0f,0.0f,0.0f),1.0f,100));
+
+      /* no statistics before the first commit */
+      RTCBuildStatistics stats;
+      rtcGetSceneBuildStatistics(scene,&stats);
+      AssertNoError(device);
+      if (stats.commitTime != 0.0 || stats.bytesAllocated != 0)
+        return VerifyApplication::FAILED;
+
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      rtcGetSceneBuildStatistics(scene,&stats);
+      AssertNoError(device);
+
+      if (stats.commitTime <= 0.0 || stats.primRefTime < 0.0 || stats.hierarchyTime <= 0.0)
+        return VerifyApplication::FAILED;
+      if (stats.numThreads == 0 || stats.threadUtilization < 0.0f || stats.threadUtilization > 1.0f)
+        return VerifyApplication::FAILED;
+      if (stats.bytesUsed == 0 || stats.bytesUsed > stats.bytesAllocated)
+        return VerifyApplication::FAILED;
+
+      /* the split of the hierarchy time has to add up if reported */
+      const double split = stats.binningTime+stats.spatialSplitTime+stats.leafTime;
+      if (split != 0.0 && std::abs(split-stats.hierarchyTime) > 1E-6*stats.hierarchyTime)
+        return VerifyApplication::FAILED;
+
+      return VerifyApplication::PASSED;
+    }
+  };
     
   struct NewDeleteGeometryTest : public VerifyApplication::Test
   {
@@ -1706,6 +2267,139 @@ namespace embree
     }
   };
 
+  struct DeformingSceneTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+    std::string config;
+
+    DeformingSceneTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, std::string config)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality), config(config) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+","+config;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* the deforming scene gets compared against a scene that always gets rebuilt, both share the vertex buffer */
+      VerifyScene scene0(device,sflags);
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      auto sphere = scene0.addSphere(sampler,quality,zero,1.0f,50);
+      unsigned geomID1 = scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,sphere.second);
+      RTCGeometry geom0 = rtcGetGeometry(scene0,sphere.first);
+      RTCGeometry geom1 = rtcGetGeometry(scene1,geomID1);
+      avector<Vec3fa>& positions = sphere.second.dynamicCast<SceneGraph::TriangleMeshNode>()->positions[0];
+      AssertNoError(device);
+      
+      for (size_t i=0; i<16; i++)
+      {
+        /* small deformations keep the BVH quality, swapping vertices degrades it */
+        if (i%4 == 3) {
+          for (size_t j=0; j<positions.size()/8; j++)
+            std::swap(positions[RandomSampler_getUInt(sampler)%positions.size()],positions[RandomSampler_getUInt(sampler)%positions.size()]);
+        } else {
+          for (size_t j=0; j<positions.size(); j++)
+            positions[j] += 0.01f*(RandomSampler_get3D(sampler)-Vec3fa(0.5f));
+        }
+        rtcUpdateGeometryBuffer(geom0,RTC_BUFFER_TYPE_VERTEX,0);
+        rtcUpdateGeometryBuffer(geom1,RTC_BUFFER_TYPE_VERTEX,0);
+        rtcCommitGeometry(geom0);
+        rtcCommitGeometry(geom1);
+        rtcCommitScene(scene0);
+        rtcCommitScene(scene1);
+        AssertNoError(device);
+
+        for (size_t j=0; j<256; j++)
+        {
+          const Vec3fa org = 4.0f*(RandomSampler_get3D(sampler)-Vec3fa(0.5f));
+          const Vec3fa dir = RandomSampler_get3D(sampler)-Vec3fa(0.5f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = makeRay(org,dir);
+          rtcIntersect1(scene0,&context,&ray0);
+          rtcIntersect1(scene1,&context,&ray1);
+          if ((ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) != (ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID))
+            return VerifyApplication::FAILED;
+          if (abs(ray0.ray.tfar-ray1.ray.tfar) > 1E-3f)
+            return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TopLevelUpdateTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    TopLevelUpdateTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* many spheres, such that moving only a few of them updates the top-level BVH incrementally */
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+      const size_t numSpheres = 64;
+      const size_t numPhi = 5;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      std::vector<Vec3fa> pos(numSpheres);
+      std::vector<unsigned> geomID(numSpheres);
+      std::vector<bool> moved(numSpheres,false);
+      for (size_t i=0; i<numSpheres; i++) {
+        pos[i] = Vec3fa(4.0f*float(i%8),0.0f,4.0f*float(i/8));
+        geomID[i] = scene.addSphere(sampler,RTC_BUILD_QUALITY_LOW,pos[i],1.0f,numPhi).first;
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<32; i++)
+      {
+        /* move one or two spheres sideways and back */
+        for (size_t j=0; j<1+(i%2); j++)
+        {
+          const size_t index = RandomSampler_getUInt(sampler) % numSpheres;
+          Vec3fa ds = moved[index] ? Vec3fa(-1.5f,0.0f,-1.5f) : Vec3fa(1.5f,0.0f,1.5f);
+          moved[index] = !moved[index];
+          UpdateTest::move_mesh(rtcGetGeometry(scene,geomID[index]),numVertices,ds);
+          pos[index] += ds;
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RTCRayHit rays[numSpheres];
+        for (size_t j=0; j<numSpheres; j++)
+          rays[j] = makeRay(pos[j]+Vec3fa(0.1f,100,0.1f),Vec3fa(0,-1,0));
+        IntersectWithMode(imode,ivariant,scene,rays,numSpheres);
+        for (size_t j=0; j<numSpheres; j++)
+        {
+          if (ivariant & VARIANT_INTERSECT) {
+            if (rays[j].hit.geomID != geomID[j] || abs(rays[j].ray.tfar-99.0f) > 0.5f)
+              return VerifyApplication::FAILED;
+          }
+          else {
+            if (rays[j].ray.tfar != float(neg_inf))
+              return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct GarbageGeometryTest : public VerifyApplication::Test
   {
     GarbageGeometryTest (std::string name, int isa)
@@ -2340,6 +3034,109 @@ namespace embree
     }
   };
 
+  struct InstanceLevelTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags; 
+    RTCBuildQuality quality; 
+
+    InstanceLevelTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    /* creates a chain of scenes where scene l instances scene l-1 through instance geometry l, each shifted by one unit along x */
+    void createScenes(RTCDevice device, RTCScene* scenes, unsigned int levels)
+    {
+      Vec3f* vertices = (Vec3f*) alignedMalloc(4*sizeof(Vec3f),16);
+      vertices[0] = Vec3f(0.0f,0.0f,0.0f);
+      vertices[1] = Vec3f(1.0f,0.0f,0.0f);
+      vertices[2] = Vec3f(0.0f,1.0f,0.0f);
+      vertices[3] = Vec3f(zero); // dummy vertex for 16 byte padding
+      
+      scenes[0] = rtcNewScene(device);
+      rtcSetSceneFlags(scenes[0],sflags.sflags);
+      rtcSetSceneBuildQuality(scenes[0],sflags.qflags);
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,quality);
+      memcpy(rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3), vertices, 3*sizeof(Vec3f));
+      Triangle* triangles = (Triangle*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), 1);
+      triangles[0] = Triangle(0,1,2);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scenes[0],geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scenes[0]);
+      alignedFree(vertices);
+
+      for (unsigned int l=1; l<=levels; l++)
+      {
+        scenes[l] = rtcNewScene(device);
+        rtcSetSceneFlags(scenes[l],sflags.sflags);
+        rtcSetSceneBuildQuality(scenes[l],sflags.qflags);
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,scenes[l-1]);
+        const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(1.0f,0.0f,0.0f));
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm.l.vx.x);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometryByID(scenes[l],inst,l);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene(scenes[l]);
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      const unsigned int levels = RTC_MAX_INSTANCE_LEVEL_COUNT;
+      RTCScene scenes[RTC_MAX_INSTANCE_LEVEL_COUNT+2];
+      createScenes(device,scenes,levels);
+      AssertNoError(device);
+
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        const float u = 0.1f+0.4f*random_float();
+        const float v = 0.1f+0.4f*random_float();
+        rays[i] = makeRay(Vec3fa(float(levels)+u,v,-1.0f),Vec3fa(0.0f,0.0f,1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scenes[levels],rays,256);
+
+      bool passed = true;
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT)) {
+          passed &= rays[i].ray.tfar == float(neg_inf);
+          continue;
+        }
+        passed &= rays[i].hit.geomID == 0;
+        passed &= abs(rays[i].ray.tfar - 1.0f) <= 16.0f*float(ulp);
+
+        /* the instance ID chain starts with the instance of the top level scene */
+        for (unsigned int l=0; l<levels; l++)
+          passed &= rays[i].hit.instID[l] == levels-l;
+      }
+
+      /* nesting one more level than supported has to fail at commit */
+      RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(inst,scenes[levels]);
+      rtcCommitGeometry(inst);
+      scenes[levels+1] = rtcNewScene(device);
+      rtcAttachGeometry(scenes[levels+1],inst);
+      rtcReleaseGeometry(inst);
+      AssertNoError(device);
+      rtcCommitScene(scenes[levels+1]);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      for (unsigned int l=0; l<=levels+1; l++)
+        rtcReleaseScene(scenes[l]);
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct QuadHitTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -2355,41 +3152,213 @@ namespace embree
       errorHandler(nullptr,rtcGetDeviceError(device));
       if (!supportsIntersectMode(device,imode))
         return VerifyApplication::SKIPPED;
-     
-      Vec3f vertices[5] = {
-        Vec3f(0.0f,0.0f,0.0f),
-        Vec3f(1.0f,0.0f,0.0f),
-        Vec3f(1.0f,1.0f,0.0f),
-        Vec3f(0.0f,1.0f,0.0f),
-        Vec3f(zero) // dummy vertex for 16 byte padding
-      };
-      int quads[4] = {
-        0,1,2,3
-      };
+     
+      Vec3f vertices[5] = {
+        Vec3f(0.0f,0.0f,0.0f),
+        Vec3f(1.0f,0.0f,0.0f),
+        Vec3f(1.0f,1.0f,0.0f),
+        Vec3f(0.0f,1.0f,0.0f),
+        Vec3f(zero) // dummy vertex for 16 byte padding
+      };
+      int quads[4] = {
+        0,1,2,3
+      };
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_QUAD);
+      rtcSetGeometryBuildQuality(geom, quality);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices , 0, sizeof(Vec3f), 4);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT4,  quads, 0, 4*sizeof(int), 1);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      float u[256], v[256];
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        u[i] = random_float(); 
+        v[i] = random_float();
+        if (u[i] < 0.001f || v[i] < 0.001f || u[i] > 0.999f || v[i] > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
+        Vec3fa from(0.0f,0.0f,-1.0f);
+        Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
+        rays[i] = makeRay(from,to-from);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT))
+        {
+          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;          
+          continue;
+        }
+        if (rays[i].hit.primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].hit.u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].hit.v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].ray.tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+
+        const Vec3fa org(rays[i].ray.org_x,rays[i].ray.org_y,rays[i].ray.org_z);
+        const Vec3fa dir(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
+        const Vec3fa ht  = org + rays[i].ray.tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].hit.u*(vertices[1]-vertices[0]) + rays[i].hit.v*(vertices[3]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct PointHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCGeometryType gtype;
+    SceneFlags sflags; 
+    RTCBuildQuality quality; 
+
+    PointHitTest (std::string name, int isa, RTCGeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), gtype(gtype), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* 4x4 grid of points in the z=0 plane, oriented discs are tilted towards -y */
+      const float r = 0.25f;
+      const Vec3fa n = normalize(Vec3fa(0.0f,-1.0f,-1.0f));
+      Vec3fa points[16];
+      Vec3f normals[17];
+      for (size_t i=0; i<16; i++) {
+        points[i] = Vec3fa(float(i%4),float(i/4),0.0f,r);
+        normals[i] = Vec3f(n.x,n.y,n.z);
+      }
+      normals[16] = Vec3f(zero); // dummy normal for 16 byte padding
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      rtcSetGeometryBuildQuality(geom, quality);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, points, 0, sizeof(Vec3fa), 16);
+      if (gtype == RTC_GEOMETRY_TYPE_ORIENTED_DISC_POINT)
+        rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_NORMAL, 0, RTC_FORMAT_FLOAT3, normals, 0, sizeof(Vec3f), 16);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      unsigned int primIDs[256];
+      Vec3fa offsets[256];
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        primIDs[i] = (unsigned int)random_int() % 16;
+        offsets[i] = Vec3fa(0.5f*r*(random_float()-0.5f),0.5f*r*(random_float()-0.5f),0.0f);
+        Vec3fa from = Vec3fa(points[primIDs[i]].x,points[primIDs[i]].y,-1.0f) + offsets[i];
+        rays[i] = makeRay(from,Vec3fa(0.0f,0.0f,1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT))
+        {
+          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;          
+          continue;
+        }
+        if (rays[i].hit.primID != primIDs[i]) return VerifyApplication::FAILED;
+
+        /* expected hit distance and geometry normal */
+        const Vec3fa d = offsets[i];
+        float t; Vec3fa Ng;
+        switch (gtype) {
+        case RTC_GEOMETRY_TYPE_SPHERE_POINT: t = 1.0f-sqrt(r*r-d.x*d.x-d.y*d.y); Ng = Vec3fa(d.x,d.y,t-1.0f); break;
+        case RTC_GEOMETRY_TYPE_DISC_POINT  : t = 1.0f;     Ng = Vec3fa(0.0f,0.0f,-1.0f); break;
+        default                            : t = 1.0f-d.y; Ng = n; break;
+        }
+        if (abs(rays[i].ray.tfar - t) > 1E-5f) return VerifyApplication::FAILED;
+        const Vec3fa hNg = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
+        if (reduce_max(abs(normalize(hNg) - normalize(Ng))) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct BVHHitTest : public VerifyApplication::IntersectTest
+  {
+    std::string accel;
+    RTCGeometryType gtype;
+    RTCSceneFlags sflags;
+
+    BVHHitTest (std::string name, int isa, std::string accel, RTCGeometryType gtype, IntersectMode imode, IntersectVariant ivariant, RTCSceneFlags sflags = RTC_SCENE_FLAG_NONE)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), accel(accel), gtype(gtype), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + "," + accel;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* grid of 32x32 quads or 2x32x32 triangles in the z=0 plane, large enough to require inner nodes */
+      const unsigned int W = 32;
+      std::vector<Vec3fa> vertices((W+1)*(W+1));
+      for (unsigned int y=0; y<=W; y++)
+        for (unsigned int x=0; x<=W; x++)
+          vertices[y*(W+1)+x] = Vec3fa(float(x),float(y),0.0f);
+
+      std::vector<unsigned int> indices;
+      for (unsigned int y=0; y<W; y++) {
+        for (unsigned int x=0; x<W; x++) {
+          const unsigned int v00 = y*(W+1)+x, v10 = v00+1, v01 = v00+W+1, v11 = v01+1;
+          if (gtype == RTC_GEOMETRY_TYPE_QUAD) {
+            indices.push_back(v00); indices.push_back(v10); indices.push_back(v11); indices.push_back(v01);
+          } else {
+            indices.push_back(v00); indices.push_back(v10); indices.push_back(v11);
+            indices.push_back(v00); indices.push_back(v11); indices.push_back(v01);
+          }
+        }
+      }
+      const unsigned int numIndices = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4 : 3;
+
       RTCSceneRef scene = rtcNewScene(device);
-      rtcSetSceneFlags(scene,sflags.sflags);
-      rtcSetSceneBuildQuality(scene,sflags.qflags);
-      
-      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_QUAD);
-      rtcSetGeometryBuildQuality(geom, quality);
-      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices , 0, sizeof(Vec3f), 4);
-      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT4,  quads, 0, 4*sizeof(int), 1);
+      rtcSetSceneFlags(scene,sflags);
+      RTCGeometry geom = rtcNewGeometry (device, gtype);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices.data(), 0, sizeof(Vec3fa), vertices.size());
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, numIndices == 4 ? RTC_FORMAT_UINT4 : RTC_FORMAT_UINT3, indices.data(), 0, numIndices*sizeof(unsigned int), indices.size()/numIndices);
       rtcCommitGeometry(geom);
       rtcAttachGeometry(scene,geom);
       rtcReleaseGeometry(geom);
       rtcCommitScene (scene);
       AssertNoError(device);
 
-      float u[256], v[256];
+      unsigned int primIDs[256];
       RTCRayHit rays[256];
       for (size_t i=0; i<256; i++)
       {
-        u[i] = random_float(); 
-        v[i] = random_float();
-        if (u[i] < 0.001f || v[i] < 0.001f || u[i] > 0.999f || v[i] > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
-        Vec3fa from(0.0f,0.0f,-1.0f);
-        Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
-        rays[i] = makeRay(from,to-from);
+        const unsigned int x = (unsigned int)random_int() % W;
+        const unsigned int y = (unsigned int)random_int() % W;
+        float u = 0.1f+0.8f*random_float();
+        float v = 0.1f+0.8f*random_float();
+        if (abs(u-v) < 0.05f) { u = 0.7f; v = 0.3f; } // avoid hitting the triangle diagonal
+        const unsigned int cell = y*W+x;
+        primIDs[i] = gtype == RTC_GEOMETRY_TYPE_QUAD ? cell : 2*cell + (v > u ? 1 : 0);
+        rays[i] = makeRay(Vec3fa(float(x)+u,float(y)+v,-1.0f),Vec3fa(0.0f,0.0f,1.0f));
       }
       IntersectWithMode(imode,ivariant,scene,rays,256);
 
@@ -2397,28 +3366,18 @@ namespace embree
       {
         if (!(ivariant & VARIANT_INTERSECT))
         {
-          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;          
+          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;
           continue;
         }
-        if (rays[i].hit.primID != 0) return VerifyApplication::FAILED;
-        if (abs(rays[i].hit.u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].hit.v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (rays[i].hit.primID != primIDs[i]) return VerifyApplication::FAILED;
         if (abs(rays[i].ray.tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-
-        const Vec3fa org(rays[i].ray.org_x,rays[i].ray.org_y,rays[i].ray.org_z);
-        const Vec3fa dir(rays[i].ray.dir_x,rays[i].ray.dir_y,rays[i].ray.dir_z);
-        const Vec3fa ht  = org + rays[i].ray.tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].hit.u*(vertices[1]-vertices[0]) + rays[i].hit.v*(vertices[3]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = Vec3fa(rays[i].hit.Ng_x,rays[i].hit.Ng_y,rays[i].hit.Ng_z);
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
       }
       AssertNoError(device);
-      
+
       return VerifyApplication::PASSED;
     }
   };
-  
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -2628,6 +3587,241 @@ namespace embree
     }
   };
     
+  struct TraversalStatisticsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    TraversalStatisticsTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static void acceptFilterN(const RTCFilterFunctionNArguments* const args) {
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      const bool filter = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED);
+      VerifyScene scene(device,sflags);
+      Vec3fa p0(-0.75f,-0.25f,-10.0f), dx(4,0,0), dy(0,4,0);
+      unsigned int geomID0 = scene.addPlane(sampler,quality,4,p0,dx,dy).first;
+      if (filter) {
+        RTCGeometry geom0 = rtcGetGeometry(scene,geomID0);
+        rtcSetGeometryIntersectFilterFunction(geom0,acceptFilterN);
+        rtcSetGeometryOccludedFilterFunction(geom0,acceptFilterN);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      RTCRayHit rays[16];
+      for (unsigned int iy=0; iy<4; iy++) 
+        for (unsigned int ix=0; ix<4; ix++) 
+          rays[iy*4+ix] = makeRay(Vec3fa(float(ix),float(iy),0.0f),Vec3fa(0,0,-1));
+
+      /* counters are gathered while enabled */
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_ENABLED,1);
+      rtcResetDeviceTraversalStatistics(device);
+      IntersectWithMode(imode,ivariant,scene,rays,16);
+      rtcSetDeviceProperty(device,RTC_DEVICE_PROPERTY_TRAVERSAL_STATISTICS_ENABLED,0);
+      AssertNoError(device);
+
+      RTCTraversalStatistics stats;
+      rtcGetDeviceTraversalStatistics(device,&stats);
+      AssertNoError(device);
+
+      /* ray streams count padding rays of partially filled packets */
+      bool passed = true;
+      if (ivariant & VARIANT_INTERSECT) {
+        passed &= stats.intersectRays >= 16 && stats.occludedRays == 0;
+        passed &= stats.triangleHits == 16 && stats.quadHits == 0 && stats.instanceHits == 0;
+      } else {
+        passed &= stats.occludedRays >= 16 && stats.intersectRays == 0;
+        passed &= stats.triangleHits == 0;
+      }
+      passed &= stats.leafVisits > 0 && stats.primitiveTests > 0;
+      if (filter) passed &= stats.filterCalls > 0;
+
+      /* counters stay unchanged while disabled */
+      for (unsigned int i=0; i<16; i++)
+        rays[i] = makeRay(Vec3fa(float(i%4),float(i/4),0.0f),Vec3fa(0,0,-1));
+      IntersectWithMode(imode,ivariant,scene,rays,16);
+      RTCTraversalStatistics stats1;
+      rtcGetDeviceTraversalStatistics(device,&stats1);
+      passed &= memcmp(&stats,&stats1,sizeof(RTCTraversalStatistics)) == 0;
+
+      /* reset clears all counters */
+      rtcResetDeviceTraversalStatistics(device);
+      rtcGetDeviceTraversalStatistics(device,&stats1);
+      passed &= stats1.intersectRays == 0 && stats1.occludedRays == 0 && stats1.leafVisits == 0;
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct RaySortingTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    RaySortingTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,sflags);
+      for (size_t i=0; i<8; i++) {
+        const Vec3fa pos = 8.0f*random_Vec3fa() - Vec3fa(4.0f);
+        scene.addSphere(sampler,quality,pos,0.5f+random_float(),20);
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* use multiple sort windows for the 1M mode */
+      const size_t N = imode == MODE_INTERSECT1M ? 2500 : 1000;
+      std::vector<RTCRayHit> rays0(N);
+      for (size_t i=0; i<N; i++)
+      {
+        const Vec3fa org = 10.0f*random_Vec3fa() - Vec3fa(5.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa() - Vec3fa(1.0f);
+        rays0[i] = i%7 == 0 ? makeRay(org,dir,1.0f,0.0f) : makeRay(org,dir);
+      }
+      std::vector<RTCRayHit> rays1 = rays0;
+
+      /* reordering the stream must not change the hits */
+      IntersectWithMode(imode,ivariant,scene,rays0.data(),(unsigned int)N);
+      IntersectWithMode(imode,ivariant,scene,rays1.data(),(unsigned int)N,RTC_INTERSECT_CONTEXT_FLAG_SORT_RAYS);
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        if (rays0[i].ray.tfar != rays1[i].ray.tfar)
+          return VerifyApplication::FAILED;
+        if ((ivariant & VARIANT_INTERSECT) && (rays0[i].hit.geomID != rays1[i].hit.geomID || rays0[i].hit.primID != rays1[i].hit.primID))
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct MultiHitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    unsigned int K;
+    bool instancing;
+
+    static const unsigned int numPlanes = 10;
+
+    MultiHitTest (std::string name, int isa, SceneFlags sflags, unsigned int K, bool instancing)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), K(K), instancing(instancing) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+        return VerifyApplication::SKIPPED;
+
+      /* stack of planes at z=1,2,...,numPlanes */
+      unsigned int geomIDs[numPlanes];
+      VerifyScene planes(device,sflags);
+      for (unsigned int i=0; i<numPlanes; i++)
+        geomIDs[i] = planes.addPlane(sampler,sflags.qflags,4,Vec3fa(-1.0f,-1.0f,float(i+1)),Vec3fa(2.0f,0.0f,0.0f),Vec3fa(0.0f,2.0f,0.0f)).first;
+      rtcCommitScene(planes);
+
+      VerifyScene instances(device,sflags);
+      unsigned int instID = RTC_INVALID_GEOMETRY_ID;
+      if (instancing)
+      {
+        RTCGeometry inst = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,planes);
+        const AffineSpace3fa xfm = one;
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm.l.vx.x);
+        rtcCommitGeometry(inst);
+        instID = rtcAttachGeometry(instances,inst);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene(instances);
+      }
+      RTCScene scene = instancing ? (RTCScene) instances : (RTCScene) planes;
+      AssertNoError(device);
+
+      for (unsigned int maxHits : { 4u, 16u })
+      {
+        for (unsigned int j=0; j<16; j+=K)
+        {
+          /* rays with an unbounded, a shortened, and an empty segment through the plane stack */
+          RTCRayHit rays[16];
+          unsigned int numExpected[16];
+          for (unsigned int i=0; i<K; i++)
+          {
+            const Vec3fa org(1.8f*random_float()-0.9f,1.8f*random_float()-0.9f,0.0f);
+            const float tfar = (i+j)%4 == 3 ? 5.5f : (i+j)%4 == 2 ? 0.5f : float(inf);
+            rays[i] = makeRay(org,Vec3fa(0.0f,0.0f,1.0f),0.0f,tfar);
+            numExpected[i] = min(maxHits,tfar == 5.5f ? 5u : tfar == 0.5f ? 0u : numPlanes);
+          }
+
+          std::vector<RTCHitRecord> hits(K*maxHits);
+          unsigned int numHits[16];
+          RTCIntersectContext context;
+          rtcInitIntersectContext(&context);
+          if (K == 1) {
+            numHits[0] = rtcIntersect1Hits(scene,&context,&rays[0],hits.data(),maxHits);
+          }
+          else
+          {
+            __aligned(64) int valid[16];
+            __aligned(64) char packet[sizeof(RTCRayHit16)];
+            for (unsigned int i=0; i<K; i++) {
+              valid[i] = -1;
+              setRay((RTCRayHitN*)packet,K,i,rays[i]);
+            }
+            switch (K) {
+            case 4 : rtcIntersect4Hits (valid,scene,&context,(RTCRayHit4*) packet,hits.data(),numHits,maxHits); break;
+            case 8 : rtcIntersect8Hits (valid,scene,&context,(RTCRayHit8*) packet,hits.data(),numHits,maxHits); break;
+            case 16: rtcIntersect16Hits(valid,scene,&context,(RTCRayHit16*)packet,hits.data(),numHits,maxHits); break;
+            }
+            for (unsigned int i=0; i<K; i++)
+              rays[i] = rtcGetRayHitFromRayHitN((RTCRayHitN*)packet,K,i);
+          }
+          AssertNoError(device);
+
+          /* hits have to be the nearest planes sorted by distance, the closest one also stored in the ray */
+          for (unsigned int i=0; i<K; i++)
+          {
+            if (numHits[i] != numExpected[i])
+              return VerifyApplication::FAILED;
+
+            const RTCHitRecord* hits_i = &hits[i*maxHits];
+            for (unsigned int h=0; h<numHits[i]; h++) {
+              if (abs(hits_i[h].t-float(h+1)) > 1E-4f) return VerifyApplication::FAILED;
+              if (hits_i[h].hit.geomID != geomIDs[h]) return VerifyApplication::FAILED;
+              if (hits_i[h].hit.instID[0] != instID) return VerifyApplication::FAILED;
+            }
+
+            const unsigned int geomID = numHits[i] ? hits_i[0].hit.geomID : RTC_INVALID_GEOMETRY_ID;
+            if (rays[i].hit.geomID != geomID)
+              return VerifyApplication::FAILED;
+            if (numHits[i] && rays[i].ray.tfar != hits_i[0].t)
+              return VerifyApplication::FAILED;
+          }
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct InactiveRaysTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags;
@@ -3865,13 +5059,14 @@ namespace embree
     IntersectMode imode;
     IntersectVariant ivariant;
     size_t numPhi;
+    std::string config;
     RTCDeviceRef device;
     Ref<VerifyScene> scene;
     static const size_t numRays = 16*1024*1024;
     static const size_t deltaRays = 1024;
     
-    IncoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi)
-      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), device(nullptr)  {}
+    IncoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi, std::string config = "")
+      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), config(config), device(nullptr)  {}
 
     size_t setNumPrimitives(size_t N) 
     { 
@@ -3885,6 +5080,7 @@ namespace embree
         return false;
 
       std::string cfg = state->rtcore + ",start_threads=1,set_affinity=1,isa="+stringOfISA(isa);
+      if (config != "") cfg += ","+config;
       device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
       rtcSetDeviceErrorFunction(device,errorHandler,nullptr);
@@ -4292,6 +5488,49 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
       groups.pop();
+
+      push(new TestGroup("save_load_scene_bvh",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new SaveLoadSceneBVHTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("build_memory_budget",true,true));
+      for (auto sflags : sceneFlags) 
+        if (!(sflags.sflags & RTC_SCENE_FLAG_DYNAMIC))
+          groups.top()->add(new BuildMemoryBudgetTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("low_memory_build",true,true));
+      for (auto sflags : sceneFlags) 
+        if (!(sflags.sflags & RTC_SCENE_FLAG_DYNAMIC))
+          groups.top()->add(new LowMemoryBuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("out_of_core_build",true,true));
+      for (auto sflags : sceneFlags) 
+        if (!(sflags.sflags & RTC_SCENE_FLAG_DYNAMIC) && sflags.qflags != RTC_BUILD_QUALITY_HIGH)
+          groups.top()->add(new OutOfCoreBuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("alloc_arena",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new AllocArenaTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("build_statistics",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new BuildStatisticsTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("commit_scene_async",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new CommitSceneAsyncTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("point_query",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,false));
       for (auto sflags : sceneFlags)
@@ -4326,6 +5565,31 @@ namespace embree
       }
       groups.pop();
 
+      push(new TestGroup("refit_rebuild",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new DeformingSceneTest("refit."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT,"refit_rebuild_ratio=0"));
+        groups.top()->add(new DeformingSceneTest("rebuild."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT,"refit_rebuild_ratio=2"));
+      }
+      groups.pop();
+
+      push(new TestGroup("tree_rotations",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new DeformingSceneTest("morton."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_LOW,"tree_rotation_budget=1"));
+        groups.top()->add(new DeformingSceneTest("refit."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT,"refit_rebuild_ratio=0,tree_rotation_budget=1"));
+      }
+      groups.pop();
+
+      push(new TestGroup("update_toplevel",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        for (auto imode : intersectModes) {
+          for (auto ivariant : intersectVariants) {
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new TopLevelUpdateTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+          }
+        }
+      }
+      groups.pop();
+
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom",isa));
 
       GeometryType gtypes_memory[] = { TRIANGLE_MESH, TRIANGLE_MESH_MB, QUAD_MESH, QUAD_MESH_MB, HAIR_GEOMETRY, HAIR_GEOMETRY_MB, LINE_GEOMETRY, LINE_GEOMETRY_MB };
@@ -4395,6 +5659,67 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("instance_levels",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new InstanceLevelTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("qbvh_hit",true,true));
+      for (auto accel : { "tri_accel=qbvh4.triangle4i", "tri_accel=qbvh8.triangle4i", "tri_accel=qbvh8.triangle4", "quad_accel=qbvh4.quad4i", "quad_accel=qbvh8.quad4i" })
+      {
+        const std::string name = std::string(accel).substr(std::string(accel).find('=')+1);
+        if (name.substr(0,5) == "qbvh8" && (isa & AVX) != AVX) continue;
+        const RTCGeometryType gtype = name.find("quad") != std::string::npos ? RTC_GEOMETRY_TYPE_QUAD : RTC_GEOMETRY_TYPE_TRIANGLE;
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new BVHHitTest(name+"."+to_string(imode,ivariant),isa,accel,gtype,imode,ivariant));
+      }
+      groups.pop();
+
+      push(new TestGroup("ploc_hit",true,true));
+      for (auto accel : { "bvh4.triangle4", "bvh4.triangle4v", "bvh4.triangle4i", "bvh8.triangle4", "bvh8.quad4v" })
+      {
+        const std::string name = accel;
+        if (name.substr(0,4) == "bvh8" && (isa & AVX) != AVX) continue;
+        const bool quads = name.find("quad") != std::string::npos;
+        const std::string cfg = quads ? "quad_accel="+name+",quad_builder=ploc" : "tri_accel="+name+",tri_builder=ploc";
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new BVHHitTest(name+"."+to_string(imode,ivariant),isa,cfg,quads ? RTC_GEOMETRY_TYPE_QUAD : RTC_GEOMETRY_TYPE_TRIANGLE,imode,ivariant));
+      }
+      groups.pop();
+
+      push(new TestGroup("numa_replication",true,true));
+      for (auto accel : { "bvh4.triangle4", "bvh4.triangle4i", "bvh4.quad4v", "bvh8.triangle4", "bvh8.quad4v" })
+      {
+        const std::string name = accel;
+        if (name.substr(0,4) == "bvh8" && (isa & AVX) != AVX) continue;
+        const bool quads = name.find("quad") != std::string::npos;
+        const std::string cfg = quads ? "quad_accel="+name : "tri_accel="+name;
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              groups.top()->add(new BVHHitTest(name+"."+to_string(imode,ivariant),isa,cfg,quads ? RTC_GEOMETRY_TYPE_QUAD : RTC_GEOMETRY_TYPE_TRIANGLE,imode,ivariant,RTC_SCENE_FLAG_NUMA_REPLICATION));
+      }
+      groups.pop();
+
+      push(new TestGroup("point_hit",true,true));
+      for (auto gtype : { RTC_GEOMETRY_TYPE_SPHERE_POINT, RTC_GEOMETRY_TYPE_DISC_POINT, RTC_GEOMETRY_TYPE_ORIENTED_DISC_POINT })
+      {
+        const std::string name = gtype == RTC_GEOMETRY_TYPE_SPHERE_POINT ? "sphere" : gtype == RTC_GEOMETRY_TYPE_DISC_POINT ? "disc" : "oriented_disc";
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new PointHitTest(name+"."+to_string(sflags,imode,ivariant),isa,gtype,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+      }
+      groups.pop();
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_MASK_SUPPORTED)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -4436,6 +5761,30 @@ namespace embree
       }
       groups.pop();
       
+      /* counters are global, thus these tests cannot run in parallel */
+      push(new TestGroup("traversal_statistics",true,false));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant) && (ivariant & VARIANT_INTERSECT_OCCLUDED_MASK) != VARIANT_INTERSECT_OCCLUDED)
+              groups.top()->add(new TraversalStatisticsTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("ray_sorting",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (imode >= MODE_INTERSECT1M && has_variant(imode,ivariant) && (ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_INCOHERENT)
+              groups.top()->add(new RaySortingTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("multi_hit",true,true));
+      for (auto sflags : sceneFlags)
+        for (unsigned int K : { 1u, 4u, 8u, 16u })
+          for (bool instancing : { false, true })
+            groups.top()->add(new MultiHitTest(to_string(sflags)+".ray"+std::to_string(K)+(instancing ? ".instancing" : ""),isa,sflags,K,instancing));
+      groups.pop();
+      
       push(new TestGroup("inactive_rays",true,true));
       for (auto sflags : sceneFlags) 
         for (auto imode : intersectModes) 
@@ -4616,6 +5965,21 @@ namespace embree
             groups.top()->add(new IncoherentRaysBenchmark("incoherent."+to_string(gtype)+"_1000k."+to_string(sflags.first,imode.first,imode.second),
                                                           isa,gtype,sflags.first,sflags.second,imode.first,imode.second,501));
 
+      /* compare against the incoherent benchmarks above on multi-socket systems */
+      std::vector<std::pair<std::string,std::string>> benchmark_numa_modes;
+      benchmark_numa_modes.push_back(std::make_pair("numa_first_touch","numa=1"));
+      benchmark_numa_modes.push_back(std::make_pair("numa_interleave","numa=2"));
+
+      for (auto numa : benchmark_numa_modes)
+        for (auto imode : benchmark_imodes_ivariants)
+          groups.top()->add(new IncoherentRaysBenchmark("incoherent_"+numa.first+"."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(benchmark_sflags_quality[0].first,imode.first,imode.second),
+                                                        isa,TRIANGLE_MESH,benchmark_sflags_quality[0].first,benchmark_sflags_quality[0].second,imode.first,imode.second,501,numa.second));
+
+      const SceneFlags replicated_sflags(RTC_SCENE_FLAG_NUMA_REPLICATION,RTC_BUILD_QUALITY_MEDIUM);
+      for (auto imode : benchmark_imodes_ivariants)
+        groups.top()->add(new IncoherentRaysBenchmark("incoherent_numa_replication."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(replicated_sflags,imode.first,imode.second),
+                                                      isa,TRIANGLE_MESH,replicated_sflags,RTC_BUILD_QUALITY_MEDIUM,imode.first,imode.second,501,"numa=1"));
+
       std::vector<std::pair<SceneFlags,RTCBuildQuality>> benchmark_create_sflags_quality;
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));